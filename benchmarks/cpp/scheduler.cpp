@@ -0,0 +1,95 @@
+// Copyright © 2024 Apple Inc.
+
+#include <future>
+#include <thread>
+
+#include "mlx/mlx.h"
+#include "mlx/scheduler.h"
+#include "time_utils.h"
+
+namespace mx = mlx::core;
+
+template <typename F>
+void time_per_op(const char* msg, int num_ops, F fn) {
+  // warmup
+  fn();
+  auto start = time_now();
+  fn();
+  auto end = time_now();
+  std::cout << "Timing " << msg << " ... " << std::setprecision(5)
+            << 1e3 * milliseconds(end - start) / num_ops << " usec/op"
+            << std::endl;
+}
+
+// Round trip of empty tasks through a stream thread
+void time_enqueue(const mx::Stream& s) {
+  int num_tasks = 100000;
+  auto enqueue = [&]() {
+    for (int i = 0; i < num_tasks; i++) {
+      mx::scheduler::enqueue(s, []() {});
+    }
+    mx::synchronize(s);
+  };
+  time_per_op("enqueue empty tasks", num_tasks, enqueue);
+
+  // Several threads feeding the same stream
+  int num_threads = 4;
+  auto enqueue_threads = [&]() {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+      threads.emplace_back([&]() {
+        for (int i = 0; i < num_tasks / num_threads; i++) {
+          mx::scheduler::enqueue(s, []() {});
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    mx::synchronize(s);
+  };
+  time_per_op("enqueue empty tasks from 4 threads", num_tasks, enqueue_threads);
+
+  // Waiting for each task like a decode loop does
+  int num_sync = 10000;
+  auto enqueue_sync = [&]() {
+    for (int i = 0; i < num_sync; i++) {
+      mx::synchronize(s);
+    }
+  };
+  time_per_op("enqueue and wait", num_sync, enqueue_sync);
+}
+
+// Tiny ops where dispatch dominates
+void time_tiny_ops(const mx::Stream& s) {
+  int num_ops = 10000;
+  auto x = mx::array(1.0f);
+  mx::eval(x);
+
+  auto chain = [&]() {
+    auto y = x;
+    for (int i = 0; i < num_ops; i++) {
+      y = mx::add(y, x, s);
+    }
+    mx::eval(y);
+  };
+  time_per_op("chain of scalar adds", num_ops, chain);
+
+  auto decode = [&]() {
+    auto y = x;
+    for (int i = 0; i < num_ops / 10; i++) {
+      y = mx::add(y, x, s);
+      mx::eval(y);
+    }
+  };
+  time_per_op("scalar add with eval", num_ops / 10, decode);
+}
+
+int main() {
+  auto s = mx::default_stream(mx::Device::cpu);
+  time_enqueue(s);
+  time_tiny_ops(s);
+  if (mx::metal::is_available()) {
+    time_tiny_ops(mx::default_stream(mx::Device::gpu));
+  }
+}
@@ -1,7 +1,15 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <limits>
 #include <sstream>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 #include "mlx/allocator.h"
 #include "mlx/scheduler.h"
@@ -18,30 +26,250 @@ Buffer malloc(size_t size) {
   return buffer;
 }
 
+namespace {
+
+thread_local BufferPool* thread_pool = nullptr;
+
+thread_local size_t thread_allocated = 0;
+
+struct PoolBuffers {
+  std::mutex mtx;
+  std::unordered_map<void*, BufferPool*> owners;
+  std::atomic<size_t> size{0};
+};
+
+PoolBuffers& pool_buffers() {
+  static PoolBuffers pool_buffers_;
+  return pool_buffers_;
+}
+
+} // namespace
+
 void free(Buffer buffer) {
+  auto& pb = pool_buffers();
+  if (pb.size.load(std::memory_order_acquire) > 0) {
+    // The pool is called with the lock held so that it cannot be torn down
+    // while it takes the buffer back
+    std::lock_guard<std::mutex> lk(pb.mtx);
+    if (auto it = pb.owners.find(buffer.ptr()); it != pb.owners.end()) {
+      it->second->free(buffer);
+      return;
+    }
+  }
   allocator().free(buffer);
 }
 
-Buffer CommonAllocator::malloc(size_t size, bool) {
-  void* ptr = std::malloc(size + sizeof(size_t));
-  if (ptr != nullptr) {
+BufferPool* set_thread_pool(BufferPool* pool) {
+  std::swap(pool, thread_pool);
+  return pool;
+}
+
+void register_pool_buffer(Buffer buffer, BufferPool* pool) {
+  auto& pb = pool_buffers();
+  std::lock_guard<std::mutex> lk(pb.mtx);
+  pb.owners[buffer.ptr()] = pool;
+  pb.size.store(pb.owners.size(), std::memory_order_release);
+}
+
+void unregister_pool_buffer(Buffer buffer) {
+  auto& pb = pool_buffers();
+  std::lock_guard<std::mutex> lk(pb.mtx);
+  pb.owners.erase(buffer.ptr());
+  pb.size.store(pb.owners.size(), std::memory_order_release);
+}
+
+namespace {
+
+size_t page_size() {
+#ifdef _WIN32
+  return 4096;
+#else
+  static size_t page_size_ = sysconf(_SC_PAGESIZE);
+  return page_size_;
+#endif
+}
+
+size_t total_memory() {
+#ifdef _WIN32
+  return std::numeric_limits<size_t>::max();
+#else
+  return static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * page_size();
+#endif
+}
+
+// Round small sizes up to a power of two and larger ones to a whole number of
+// pages so that freed buffers are likely to fit later requests.
+size_t bucket_size(size_t size) {
+  constexpr size_t min_bucket = 16;
+  if (size > page_size()) {
+    return page_size() * ((size + page_size() - 1) / page_size());
+  }
+  size_t bucket = min_bucket;
+  while (bucket < size) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+} // namespace
+
+BufferCache::~BufferCache() {
+  clear();
+}
+
+void BufferCache::clear() {
+  for (auto& holder : buffer_list_) {
+    std::free(holder.buf);
+  }
+  buffer_list_.clear();
+  buffer_pool_.clear();
+  pool_size_ = 0;
+}
+
+void BufferCache::remove(BufferList::iterator it) {
+  pool_size_ -= it->pos->first;
+  buffer_pool_.erase(it->pos);
+  buffer_list_.erase(it);
+}
+
+void* BufferCache::reuse_from_cache(size_t size) {
+  // Find the closest buffer in pool and make sure we use most of it
+  auto it = buffer_pool_.lower_bound(size);
+  if (it == buffer_pool_.end() ||
+      it->first >= std::min(2 * size, size + 2 * page_size())) {
+    return nullptr;
+  }
+  void* buf = it->second->buf;
+  remove(it->second);
+  return buf;
+}
+
+void BufferCache::recycle_to_cache(void* buf, size_t size) {
+  buffer_list_.push_front({buf, {}});
+  buffer_list_.front().pos = buffer_pool_.insert({size, buffer_list_.begin()});
+  pool_size_ += size;
+}
+
+void BufferCache::release_cached_buffers(size_t min_bytes_to_free) {
+  if (min_bytes_to_free >= 0.9 * pool_size_) {
+    clear();
+    return;
+  }
+  size_t total_bytes_freed = 0;
+  while (!buffer_list_.empty() && total_bytes_freed < min_bytes_to_free) {
+    auto it = std::prev(buffer_list_.end());
+    total_bytes_freed += it->pos->first;
+    std::free(it->buf);
+    remove(it);
+  }
+}
+
+CommonAllocator::CommonAllocator() {
+  block_limit_ = 0.95 * total_memory();
+  gc_limit_ = block_limit_;
+  max_pool_size_ = block_limit_;
+}
+
+size_t CommonAllocator::set_cache_limit(size_t limit) {
+  std::unique_lock lk(mutex_);
+  std::swap(limit, max_pool_size_);
+  if (buffer_cache_.cache_size() > max_pool_size_) {
+    buffer_cache_.release_cached_buffers(
+        buffer_cache_.cache_size() - max_pool_size_);
+  }
+  return limit;
+}
+
+size_t CommonAllocator::set_memory_limit(size_t limit, bool relaxed) {
+  std::unique_lock lk(mutex_);
+  std::swap(limit, block_limit_);
+  relaxed_ = relaxed;
+  gc_limit_ =
+      std::min(block_limit_, static_cast<size_t>(0.95 * total_memory()));
+  return limit;
+}
+
+void CommonAllocator::clear_cache() {
+  std::unique_lock lk(mutex_);
+  buffer_cache_.clear();
+}
+
+Buffer CommonAllocator::malloc(size_t size, bool allow_swap /* = false */) {
+  size = bucket_size(size);
+
+  // Try the cache
+  std::unique_lock lk(mutex_);
+  void* ptr = buffer_cache_.reuse_from_cache(size);
+  if (!ptr) {
+    size_t mem_required = active_memory_ + buffer_cache_.cache_size() + size;
+
+    // If there is too much memory pressure, fail (likely causes a wait).
+    if (!(allow_swap && relaxed_) && mem_required >= block_limit_) {
+      return Buffer{nullptr};
+    }
+
+    // If we have a lot of memory pressure try to reclaim memory from the
+    // cache
+    if (mem_required >= gc_limit_) {
+      buffer_cache_.release_cached_buffers(mem_required - gc_limit_);
+    }
+
+    lk.unlock();
+    ptr = std::malloc(size + sizeof(size_t));
+    if (ptr == nullptr) {
+      return Buffer{nullptr};
+    }
     *static_cast<size_t*>(ptr) = size;
+    lk.lock();
+  }
+
+  active_memory_ += size;
+  peak_memory_ = std::max(peak_memory_, active_memory_);
+
+  // Maintain the cache below the requested limit
+  if (buffer_cache_.cache_size() >= max_pool_size_) {
+    buffer_cache_.release_cached_buffers(
+        buffer_cache_.cache_size() - max_pool_size_);
   }
+
   return Buffer{ptr};
 }
 
 void CommonAllocator::free(Buffer buffer) {
-  std::free(buffer.ptr());
+  void* ptr = buffer.ptr();
+  if (ptr == nullptr) {
+    return;
+  }
+  size_t size = this->size(buffer);
+  std::unique_lock lk(mutex_);
+  active_memory_ -= size;
+  if (buffer_cache_.cache_size() + size <= max_pool_size_) {
+    buffer_cache_.recycle_to_cache(ptr, size);
+  } else {
+    lk.unlock();
+    std::free(ptr);
+  }
 }
 
 size_t CommonAllocator::size(Buffer buffer) const {
   if (buffer.ptr() == nullptr) {
     return 0;
   }
-  return *static_cast<size_t*>(buffer.ptr());
+  return *static_cast<const size_t*>(buffer.ptr());
+}
+
+size_t get_thread_allocated() {
+  return thread_allocated;
 }
 
 Buffer malloc_or_wait(size_t size) {
+  thread_allocated += size;
+  if (thread_pool) {
+    if (auto buffer = thread_pool->malloc(size); buffer.ptr()) {
+      return buffer;
+    }
+  }
+
   auto buffer = allocator().malloc(size);
 
   while (size && !buffer.ptr() && scheduler::n_active_tasks() > 0) {
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <cstdlib>
+#include <list>
+#include <map>
+#include <mutex>
 
 namespace mlx::core::allocator {
 
@@ -36,6 +39,38 @@ void free(Buffer buffer);
 // if allocation fails
 Buffer malloc_or_wait(size_t size);
 
+// The total number of bytes requested with malloc_or_wait on the calling
+// thread
+size_t get_thread_allocated();
+
+/* A set of buffers planned ahead of an evaluation (see cpu::MemoryArena).
+ *
+ * While a pool is set on a thread, malloc_or_wait on that thread asks it for
+ * a buffer first. Buffers registered with a pool go back to it when freed
+ * instead of going to the allocator.
+ * */
+class BufferPool {
+ public:
+  // Return a buffer of at least size bytes or a null buffer to fall back to
+  // the allocator
+  virtual Buffer malloc(size_t size) = 0;
+
+  // Take back one of the registered buffers
+  virtual void free(Buffer buffer) = 0;
+
+  virtual ~BufferPool() = default;
+};
+
+// Set the pool used by malloc_or_wait on the calling thread. Returns the
+// previous one.
+BufferPool* set_thread_pool(BufferPool* pool);
+
+// Route free(buffer) to the pool until the buffer is unregistered. The
+// buffer must come from allocator().malloc so that it can be freed normally
+// once unregistered.
+void register_pool_buffer(Buffer buffer, BufferPool* pool);
+void unregister_pool_buffer(Buffer buffer);
+
 class Allocator {
   /** Abstract base class for a memory allocator. */
  public:
@@ -53,16 +88,78 @@ class Allocator {
 
 Allocator& allocator();
 
+class BufferCache {
+ public:
+  BufferCache() = default;
+  ~BufferCache();
+
+  void* reuse_from_cache(size_t size);
+  void recycle_to_cache(void* buf, size_t size);
+  void release_cached_buffers(size_t min_bytes_to_free);
+  size_t cache_size() const {
+    return pool_size_;
+  }
+  void clear();
+
+ private:
+  struct BufferHolder;
+  using BufferList = std::list<BufferHolder>;
+  using BufferPool = std::multimap<size_t, BufferList::iterator>;
+
+  struct BufferHolder {
+    void* buf;
+    BufferPool::iterator pos;
+  };
+
+  void remove(BufferList::iterator it);
+
+  // Most recently recycled buffers are at the front
+  BufferList buffer_list_;
+  BufferPool buffer_pool_;
+  size_t pool_size_{0};
+};
+
 class CommonAllocator : public Allocator {
   /** A general CPU allocator. */
  public:
   virtual Buffer malloc(size_t size, bool allow_swap = false) override;
   virtual void free(Buffer buffer) override;
   virtual size_t size(Buffer buffer) const override;
+  size_t get_active_memory() {
+    return active_memory_;
+  };
+  size_t get_peak_memory() {
+    return peak_memory_;
+  };
+  void reset_peak_memory() {
+    std::unique_lock lk(mutex_);
+    peak_memory_ = 0;
+  };
+  size_t get_cache_memory() {
+    return buffer_cache_.cache_size();
+  };
+  size_t set_cache_limit(size_t limit);
+  size_t set_memory_limit(size_t limit, bool relaxed);
+  void clear_cache();
 
  private:
-  CommonAllocator() = default;
-  friend Allocator& allocator();
+  CommonAllocator();
+  friend CommonAllocator& common_allocator();
+
+  // Caching allocator
+  BufferCache buffer_cache_;
+
+  // Allocation stats
+  size_t block_limit_;
+  size_t gc_limit_;
+  size_t active_memory_{0};
+  size_t peak_memory_{0};
+  size_t max_pool_size_;
+  bool relaxed_{true};
+
+  std::mutex mutex_;
 };
 
+CommonAllocator& common_allocator();
+
 } // namespace mlx::core::allocator
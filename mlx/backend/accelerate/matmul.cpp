@@ -6,6 +6,7 @@
 
 #include "mlx/backend/accelerate/utils.h"
 #include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/gemm.h"
 #include "mlx/primitives.h"
 #include "mlx/utils.h"
 
@@ -235,6 +236,10 @@ void Matmul::eval_cpu(const std::vector<array>& inputs, array& out) {
   if (out.dtype() == float32) {
     return matmul_cblas(inputs[0], inputs[1], out);
   }
+  if (out.dtype() == int32) {
+    out.set_data(allocator::malloc_or_wait(out.nbytes()));
+    return gemm(inputs[0], inputs[1], out);
+  }
   return matmul_bnns(inputs[0], inputs[1], out);
 }
 
@@ -47,6 +47,7 @@ DEFAULT(ExpandDims)
 DEFAULT(FFT)
 DEFAULT(Floor)
 DEFAULT(Gather)
+DEFAULT(GatherAxis)
 DEFAULT(GatherMM)
 DEFAULT(GatherQMM)
 DEFAULT(Greater)
@@ -79,6 +80,7 @@ DEFAULT(Sort)
 DEFAULT(Squeeze)
 DEFAULT(StopGradient)
 DEFAULT_MULTI(SVD)
+DEFAULT_MULTI(TopK)
 DEFAULT(Transpose)
 DEFAULT(Inverse)
 DEFAULT(Cholesky)
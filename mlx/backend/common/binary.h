@@ -5,6 +5,8 @@
 
 #include "mlx/allocator.h"
 #include "mlx/array.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
 #include "mlx/backend/common/utils.h"
 
 namespace mlx::core {
@@ -131,6 +133,9 @@ struct DefaultVectorScalar {
   DefaultVectorScalar(Op op_) : op(op_) {}
 
   void operator()(const T* a, const T* b, U* dst, int size) {
+    if (simd::binary(op, a, b, dst, size, simd::BinaryMode::VectorScalar)) {
+      return;
+    }
     T scalar = *b;
     while (size-- > 0) {
       *dst = op(*a, scalar);
@@ -147,6 +152,9 @@ struct DefaultScalarVector {
   DefaultScalarVector(Op op_) : op(op_) {}
 
   void operator()(const T* a, const T* b, U* dst, int size) {
+    if (simd::binary(op, a, b, dst, size, simd::BinaryMode::ScalarVector)) {
+      return;
+    }
     T scalar = *a;
     while (size-- > 0) {
       *dst = op(scalar, *b);
@@ -163,6 +171,9 @@ struct DefaultVectorVector {
   DefaultVectorVector(Op op_) : op(op_) {}
 
   void operator()(const T* a, const T* b, U* dst, int size) {
+    if (simd::binary(op, a, b, dst, size, simd::BinaryMode::VectorVector)) {
+      return;
+    }
     while (size-- > 0) {
       *dst = op(*a, *b);
       dst++;
@@ -205,6 +216,35 @@ void binary_op_dims(
   }
 }
 
+// Run binary_op_dims splitting the outermost axis across the intra-op pool.
+template <typename T, typename U, typename Op, int D, bool Strided>
+void binary_op_dims_parallel(
+    const T* a,
+    const T* b,
+    U* out,
+    Op op,
+    const Shape& shape,
+    const Strides& a_strides,
+    const Strides& b_strides,
+    const Strides& out_strides) {
+  int64_t inner = std::max<int64_t>(out_strides[0], 1);
+  int64_t grain = cpu::grain_size(inner);
+  cpu::parallel_for(shape[0], grain, [&](int64_t begin, int64_t end) {
+    auto chunk_shape = shape;
+    chunk_shape[0] = end - begin;
+    binary_op_dims<T, U, Op, D, Strided>(
+        a + begin * a_strides[0],
+        b + begin * b_strides[0],
+        out + begin * out_strides[0],
+        op,
+        chunk_shape,
+        a_strides,
+        b_strides,
+        out_strides,
+        0);
+  });
+}
+
 template <typename T, typename U, bool Strided, typename Op>
 void binary_op_dispatch_dims(
     const array& a,
@@ -221,60 +261,41 @@ void binary_op_dispatch_dims(
   U* out_ptr = out.data<U>();
   switch (dim) {
     case 1:
-      binary_op_dims<T, U, Op, 1, Strided>(
-          a_ptr,
-          b_ptr,
-          out_ptr,
-          op,
-          shape,
-          a_strides,
-          b_strides,
-          out_strides,
-          0);
+      binary_op_dims_parallel<T, U, Op, 1, Strided>(
+          a_ptr, b_ptr, out_ptr, op, shape, a_strides, b_strides, out_strides);
       return;
     case 2:
-      binary_op_dims<T, U, Op, 2, Strided>(
-          a_ptr,
-          b_ptr,
-          out_ptr,
-          op,
-          shape,
-          a_strides,
-          b_strides,
-          out_strides,
-          0);
+      binary_op_dims_parallel<T, U, Op, 2, Strided>(
+          a_ptr, b_ptr, out_ptr, op, shape, a_strides, b_strides, out_strides);
       return;
     case 3:
+      binary_op_dims_parallel<T, U, Op, 3, Strided>(
+          a_ptr, b_ptr, out_ptr, op, shape, a_strides, b_strides, out_strides);
+      return;
+  }
+
+  int64_t stride = std::max<int64_t>(out_strides[dim - 4], 1);
+  int64_t grain = cpu::grain_size(stride);
+  cpu::parallel_for(a.size() / stride, grain, [&](int64_t begin, int64_t end) {
+    ContiguousIterator a_it(shape, a_strides, dim - 3);
+    ContiguousIterator b_it(shape, b_strides, dim - 3);
+    a_it.seek(begin);
+    b_it.seek(begin);
+    for (int64_t i = begin; i < end; i++) {
       binary_op_dims<T, U, Op, 3, Strided>(
-          a_ptr,
-          b_ptr,
-          out_ptr,
+          a_ptr + a_it.loc,
+          b_ptr + b_it.loc,
+          out_ptr + i * stride,
           op,
           shape,
           a_strides,
           b_strides,
           out_strides,
-          0);
-      return;
-  }
-
-  ContiguousIterator a_it(shape, a_strides, dim - 3);
-  ContiguousIterator b_it(shape, b_strides, dim - 3);
-  auto stride = out_strides[dim - 4];
-  for (int64_t elem = 0; elem < a.size(); elem += stride) {
-    binary_op_dims<T, U, Op, 3, Strided>(
-        a_ptr + a_it.loc,
-        b_ptr + b_it.loc,
-        out_ptr + elem,
-        op,
-        shape,
-        a_strides,
-        b_strides,
-        out_strides,
-        dim - 3);
-    a_it.step();
-    b_it.step();
-  }
+          dim - 3);
+      a_it.step();
+      b_it.step();
+    }
+  });
 }
 
 template <
@@ -303,19 +324,34 @@ void binary_op(
 
   // The full computation is scalar vector so delegate to the op
   if (bopt == BinaryOpType::ScalarVector) {
-    opsv(a.data<T>(), b.data<T>(), out.data<U>(), b.data_size());
+    const T* a_ptr = a.data<T>();
+    const T* b_ptr = b.data<T>();
+    U* out_ptr = out.data<U>();
+    cpu::parallel_for(b.data_size(), [&](int64_t begin, int64_t end) {
+      opsv(a_ptr, b_ptr + begin, out_ptr + begin, end - begin);
+    });
     return;
   }
 
   // The full computation is vector scalar so delegate to the op
   if (bopt == BinaryOpType::VectorScalar) {
-    opvs(a.data<T>(), b.data<T>(), out.data<U>(), a.data_size());
+    const T* a_ptr = a.data<T>();
+    const T* b_ptr = b.data<T>();
+    U* out_ptr = out.data<U>();
+    cpu::parallel_for(a.data_size(), [&](int64_t begin, int64_t end) {
+      opvs(a_ptr + begin, b_ptr, out_ptr + begin, end - begin);
+    });
     return;
   }
 
   // The full computation is vector vector so delegate to the op
   if (bopt == BinaryOpType::VectorVector) {
-    opvv(a.data<T>(), b.data<T>(), out.data<U>(), out.size());
+    const T* a_ptr = a.data<T>();
+    const T* b_ptr = b.data<T>();
+    U* out_ptr = out.data<U>();
+    cpu::parallel_for(out.size(), [&](int64_t begin, int64_t end) {
+      opvv(a_ptr + begin, b_ptr + begin, out_ptr + begin, end - begin);
+    });
     return;
   }
 
@@ -1,15 +1,14 @@
 // Copyright © 2023-2024 Apple Inc.
 
 #include <dlfcn.h>
-#include <filesystem>
-#include <fstream>
 #include <list>
 #include <mutex>
 #include <shared_mutex>
 
 #include "mlx/backend/common/compiled.h"
 #include "mlx/backend/common/compiled_preamble.h"
-#include "mlx/backend/common/jit_compiler.h"
+#include "mlx/backend/common/kernel_cache.h"
+#include "mlx/backend/common/parallel.h"
 #include "mlx/device.h"
 #include "mlx/graph_utils.h"
 
@@ -64,61 +63,19 @@ void* compile(
     return it->second;
   }
   std::string source_code = source_builder();
-  std::string kernel_file_name;
-
-  // Deal with long kernel names. Maximum length for filename on macOS is 255
-  // characters, and on Windows the maximum length for whole path is 260. Clip
-  // file name with a little extra room and append a 16 character hash.
-#ifdef _WIN32
-  constexpr int max_file_name_length = 140;
-#else
-  constexpr int max_file_name_length = 245;
-#endif
-  if (kernel_name.size() > max_file_name_length) {
-    std::ostringstream file_name;
-    file_name
-        << std::string_view(kernel_name).substr(0, max_file_name_length - 16);
-    auto file_id =
-        std::hash<std::string>{}(kernel_name.substr(max_file_name_length - 16));
-    file_name << "_" << std::hex << std::setw(16) << file_id << std::dec;
-    kernel_file_name = file_name.str();
-  } else {
-    kernel_file_name = kernel_name;
-  }
 
-  auto output_dir = std::filesystem::temp_directory_path();
-
-  std::string shared_lib_name = "lib" + kernel_file_name + ".so";
-  auto shared_lib_path = (output_dir / shared_lib_name).string();
-  bool lib_exists = false;
-  {
-    std::ifstream f(shared_lib_path.c_str());
-    lib_exists = f.good();
+  // Load the library from the kernel cache. If it was evicted by another
+  // process before we could load it, compile it again.
+  auto& kernel_cache = KernelCache::instance();
+  auto shared_lib_path = kernel_cache.get(kernel_name, source_code);
+  try {
+    cache.libs.emplace_back(shared_lib_path.string());
+  } catch (const std::runtime_error&) {
+    kernel_cache.remove(shared_lib_path);
+    shared_lib_path = kernel_cache.get(kernel_name, source_code);
+    cache.libs.emplace_back(shared_lib_path.string());
   }
 
-  if (!lib_exists) {
-    // Open source file and write source code to it
-    std::string source_file_name = kernel_file_name + ".cpp";
-    auto source_file_path = (output_dir / source_file_name).string();
-
-    std::ofstream source_file(source_file_path);
-    source_file << source_code;
-    source_file.close();
-
-    std::string command = JitCompiler::build_command(
-        output_dir, source_file_name, shared_lib_name);
-    auto return_code = system(command.c_str());
-    if (return_code) {
-      std::ostringstream msg;
-      msg << "[Compile::eval_cpu] Failed to compile function " << kernel_name
-          << " with error code " << return_code << "." << std::endl;
-      throw std::runtime_error(msg.str());
-    }
-  }
-
-  // load library
-  cache.libs.emplace_back(shared_lib_path);
-
   // Load function
   void* fun = dlsym(cache.libs.back().lib, kernel_name.c_str());
   if (!fun) {
@@ -132,6 +89,11 @@ void* compile(
   return fun;
 }
 
+// The kernels process a range of the output so that they can be split across
+// the intra-op thread pool. Contiguous kernels take a range of elements and
+// compile to a flat loop over restrict pointers which the compiler can
+// vectorize. Strided kernels take a range of rows, that is of indices into
+// all but the last dimension, and loop over the last dimension inside a row.
 inline void build_kernel(
     std::ostream& os,
     const std::string& kernel_name,
@@ -149,6 +111,9 @@ inline void build_kernel(
   auto is_constant = [&constant_ids](const array& x) {
     return constant_ids.find(x.id()) != constant_ids.end();
   };
+  auto is_strided = [&](const array& x) {
+    return !contiguous && !is_constant(x) && !is_scalar(x);
+  };
 
   NodeNamer namer;
 
@@ -158,7 +123,8 @@ inline void build_kernel(
 #endif
 
   // Start the kernel
-  os << "void " << kernel_name << "(void** args) {" << std::endl;
+  os << "void " << kernel_name
+     << "(void** args, size_t begin, size_t end) {" << std::endl;
 
   // Add the input arguments
   int cnt = 0;
@@ -171,8 +137,8 @@ inline void build_kernel(
     }
 
     auto tstr = get_type_string(x.dtype());
-    os << "  " << tstr << "* " << xname << " = (" << tstr << "*)args[" << cnt++
-       << "];" << std::endl;
+    os << "  const " << tstr << "* __restrict " << xname << " = (" << tstr
+       << "*)args[" << cnt++ << "];" << std::endl;
     // Scalars and contiguous need no strides
     if (!is_scalar(x) && !contiguous) {
       os << "  const size_t* " << xname << "_strides = (size_t*)args[" << cnt++
@@ -183,42 +149,91 @@ inline void build_kernel(
   // Add the output arguments
   for (auto& x : outputs) {
     auto tstr = get_type_string(x.dtype());
-    os << "  " << tstr << "* " << namer.get_name(x) << " = (" << tstr
-       << "*)args[" << cnt++ << "];" << std::endl;
+    os << "  " << tstr << "* __restrict " << namer.get_name(x) << " = ("
+       << tstr << "*)args[" << cnt++ << "];" << std::endl;
   }
-  // Add output strides and shape to extract the indices.
+  // Add the output shape to extract the indices.
   if (!contiguous) {
     os << "  const int* shape = (int*)args[" << cnt++ << "];" << std::endl;
-  } else {
-    os << "  const size_t size = (size_t)args[" << cnt++ << "];" << std::endl;
+    os << "  const int n = shape[" << ndim - 1 << "];" << std::endl;
+  }
+
+  // Hoist the constants and scalars out of the loops
+  for (auto& x : inputs) {
+    auto& xname = namer.get_name(x);
+    if (is_constant(x)) {
+      os << "  const " << get_type_string(x.dtype()) << " tmp_" << xname
+         << " = ";
+      print_constant(os, x);
+      os << ";" << std::endl;
+    } else if (is_scalar(x)) {
+      os << "  const " << get_type_string(x.dtype()) << " tmp_" << xname
+         << " = " << xname << "[0];" << std::endl;
+    }
   }
 
   if (contiguous) {
-    os << "  for (size_t i = 0; i < size; ++i) {" << std::endl;
+    os << "  for (size_t i = begin; i < end; ++i) {" << std::endl;
   } else {
-    for (int d = 0; d < ndim; ++d) {
-      os << "  for (int i" << d << " = 0; i" << d << " < shape[" << d
-         << "]; ++i" << d << ") {" << std::endl;
+    os << "  for (size_t r = begin; r < end; ++r) {" << std::endl;
+
+    // Find the start of the row in each input
+    for (auto& x : inputs) {
+      if (is_strided(x)) {
+        auto& xname = namer.get_name(x);
+        auto tstr = get_type_string(x.dtype());
+        os << "  const " << tstr << "* __restrict " << xname << "_row = "
+           << xname << ";" << std::endl;
+      }
     }
+    if (ndim > 1) {
+      os << "  size_t idx = r;" << std::endl;
+    }
+    for (int d = ndim - 2; d >= 0; --d) {
+      os << "  {" << std::endl;
+      os << "  size_t i" << d << " = idx % shape[" << d << "];" << std::endl;
+      if (d > 0) {
+        os << "  idx /= shape[" << d << "];" << std::endl;
+      }
+      for (auto& x : inputs) {
+        if (is_strided(x)) {
+          auto& xname = namer.get_name(x);
+          os << "  " << xname << "_row += i" << d << " * " << xname
+             << "_strides[" << d << "];" << std::endl;
+        }
+      }
+      os << "  }" << std::endl;
+    }
+
+    // Outputs are row contiguous
+    for (auto& x : outputs) {
+      auto& xname = namer.get_name(x);
+      auto tstr = get_type_string(x.dtype());
+      os << "  " << tstr << "* __restrict " << xname << "_row = " << xname
+         << " + r * n;" << std::endl;
+    }
+    for (auto& x : inputs) {
+      if (is_strided(x)) {
+        auto& xname = namer.get_name(x);
+        os << "  const size_t " << xname << "_stride = " << xname
+           << "_strides[" << ndim - 1 << "];" << std::endl;
+      }
+    }
+    os << "  for (int i = 0; i < n; ++i) {" << std::endl;
   }
 
   // Read the inputs in tmps
   for (auto& x : inputs) {
+    if (is_constant(x) || is_scalar(x)) {
+      continue;
+    }
     auto& xname = namer.get_name(x);
-
-    if (is_constant(x)) {
-      os << "  " << get_type_string(x.dtype()) << " tmp_" << xname << " = ";
-      print_constant(os, x);
-      os << ";" << std::endl;
-    } else if (is_scalar(x)) {
-      os << "  " << get_type_string(x.dtype()) << " tmp_" << xname << " = "
-         << xname << "[0];" << std::endl;
-    } else if (contiguous) {
-      os << "  " << get_type_string(x.dtype()) << " tmp_" << xname << " = "
-         << xname << "[i];" << std::endl;
+    os << "  " << get_type_string(x.dtype()) << " tmp_" << xname << " = "
+       << xname;
+    if (contiguous) {
+      os << "[i];" << std::endl;
     } else {
-      os << "  " << get_type_string(x.dtype()) << " tmp_" << xname << " = *"
-         << xname << ";" << std::endl;
+      os << "_row[i * " << xname << "_stride];" << std::endl;
     }
   }
 
@@ -241,35 +256,15 @@ inline void build_kernel(
 
   // Write the outputs from tmps
   for (auto& x : outputs) {
-    if (contiguous) {
-      os << "  " << namer.get_name(x) << "[i] = tmp_" << namer.get_name(x)
-         << ";" << std::endl;
-    } else {
-      os << "  *" << namer.get_name(x) << "++ = tmp_" << namer.get_name(x)
-         << ";" << std::endl;
-    }
+    auto& xname = namer.get_name(x);
+    os << "  " << xname << (contiguous ? "" : "_row") << "[i] = tmp_" << xname
+       << ";" << std::endl;
   }
 
   // Close loops
-  if (contiguous) {
+  os << "  }" << std::endl;
+  if (!contiguous) {
     os << "  }" << std::endl;
-  } else {
-    for (int d = ndim - 1; d >= 0; --d) {
-      // Update pointers
-      for (auto& x : inputs) {
-        if (is_constant(x) || is_scalar(x)) {
-          continue;
-        }
-        auto& xname = namer.get_name(x);
-        os << "  " << xname << " += " << xname << "_strides[" << d << "];"
-           << std::endl;
-        if (d < ndim - 1) {
-          os << "  " << xname << " -= " << xname << "_strides[" << d + 1 << "]"
-             << " * shape[" << d + 1 << "];" << std::endl;
-        }
-      }
-      os << "  }" << std::endl;
-    }
   }
 
   // Finish the kernel
@@ -279,8 +274,13 @@ inline void build_kernel(
 void Compiled::eval_cpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
-  if (kernel_lib_.empty()) {
-    kernel_lib_ = build_lib_name(inputs_, outputs_, tape_, constant_ids_);
+  {
+    // Independent nodes sharing this primitive can be evaluated concurrently
+    static std::mutex mtx;
+    std::lock_guard<std::mutex> lk(mtx);
+    if (kernel_lib_.empty()) {
+      kernel_lib_ = build_lib_name(inputs_, outputs_, tape_, constant_ids_);
+    }
   }
 
   // Figure out which kernel we are using
@@ -361,11 +361,24 @@ void Compiled::eval_cpu(
   }
   if (!contiguous) {
     args.push_back((void*)outputs[0].shape().data());
+  }
+
+  // Split the elements, or the rows for strided kernels, across the thread
+  // pool. Small outputs run inline on the calling thread.
+  auto fun = (void (*)(void**, size_t, size_t))fn_ptr;
+  int64_t size;
+  int64_t grain;
+  if (contiguous) {
+    size = outputs[0].data_size();
+    grain = cpu::grain_size(std::max<int64_t>(tape_.size(), 1));
   } else {
-    args.push_back((void*)outputs[0].data_size());
+    int64_t n = ndim > 0 ? shape.back() : 1;
+    size = n > 0 ? outputs[0].size() / n : 0;
+    grain = cpu::grain_size(n * std::max<int64_t>(tape_.size(), 1));
   }
-  auto fun = (void (*)(void**))fn_ptr;
-  fun(args.data());
+  cpu::parallel_for(size, grain, [&](int64_t begin, int64_t end) {
+    fun(args.data(), begin, end);
+  });
 }
 
 } // namespace mlx::core
@@ -4,6 +4,8 @@
 
 #include "mlx/allocator.h"
 #include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
 #include "mlx/backend/common/utils.h"
 
 namespace mlx::core {
@@ -14,16 +16,21 @@ template <typename SrcT, typename DstT>
 void copy_single(const array& src, array& dst) {
   auto val = static_cast<DstT>(src.data<SrcT>()[0]);
   auto dst_ptr = dst.data<DstT>();
-  for (int i = 0; i < dst.size(); ++i) {
-    dst_ptr[i] = val;
-  }
+  cpu::parallel_for(dst.size(), [&](int64_t begin, int64_t end) {
+    std::fill(dst_ptr + begin, dst_ptr + end, val);
+  });
 }
 
 template <typename SrcT, typename DstT>
 void copy_vector(const array& src, array& dst) {
   auto src_ptr = src.data<SrcT>();
   auto dst_ptr = dst.data<DstT>();
-  std::copy(src_ptr, src_ptr + src.data_size(), dst_ptr);
+  cpu::parallel_for(src.data_size(), [&](int64_t begin, int64_t end) {
+    if (simd::convert(src_ptr + begin, dst_ptr + begin, end - begin)) {
+      return;
+    }
+    std::copy(src_ptr + begin, src_ptr + end, dst_ptr + begin);
+  });
 }
 
 template <typename SrcT, typename DstT, int D>
@@ -50,6 +57,30 @@ inline void copy_dims(
   }
 }
 
+// Run copy_dims splitting the outermost axis across the intra-op pool.
+template <typename SrcT, typename DstT, int D>
+void copy_dims_parallel(
+    const SrcT* src,
+    DstT* dst,
+    const Shape& shape,
+    const Strides& i_strides,
+    const Strides& o_strides) {
+  int64_t inner = std::accumulate(
+      shape.begin() + 1, shape.end(), int64_t(1), std::multiplies<int64_t>());
+  int64_t grain = cpu::grain_size(inner);
+  cpu::parallel_for(shape[0], grain, [&](int64_t begin, int64_t end) {
+    auto chunk_shape = shape;
+    chunk_shape[0] = end - begin;
+    copy_dims<SrcT, DstT, D>(
+        src + begin * i_strides[0],
+        dst + begin * o_strides[0],
+        chunk_shape,
+        i_strides,
+        o_strides,
+        0);
+  });
+}
+
 template <typename SrcT, typename DstT>
 void copy_general_general(
     const array& src,
@@ -71,33 +102,40 @@ void copy_general_general(
   auto dst_ptr = dst.data<DstT>() + o_offset;
   int ndim = shape.size();
   if (ndim == 1) {
-    copy_dims<SrcT, DstT, 1>(
-        src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
+    copy_dims_parallel<SrcT, DstT, 1>(
+        src_ptr, dst_ptr, shape, strides[0], strides[1]);
     return;
   } else if (ndim == 2) {
-    copy_dims<SrcT, DstT, 2>(
-        src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
+    copy_dims_parallel<SrcT, DstT, 2>(
+        src_ptr, dst_ptr, shape, strides[0], strides[1]);
     return;
   } else if (ndim == 3) {
-    copy_dims<SrcT, DstT, 3>(
-        src_ptr, dst_ptr, shape, strides[0], strides[1], 0);
+    copy_dims_parallel<SrcT, DstT, 3>(
+        src_ptr, dst_ptr, shape, strides[0], strides[1]);
     return;
   }
-  ContiguousIterator in(shape, strides[0], ndim - 3);
-  ContiguousIterator out(shape, strides[1], ndim - 3);
   auto stride = std::accumulate(
       shape.end() - 3, shape.end(), 1, std::multiplies<int64_t>());
-  for (int64_t elem = 0; elem < src.size(); elem += stride) {
-    copy_dims<SrcT, DstT, 3>(
-        src_ptr + in.loc,
-        dst_ptr + out.loc,
-        shape,
-        strides[0],
-        strides[1],
-        ndim - 3);
-    in.step();
-    out.step();
-  }
+  stride = std::max<int64_t>(stride, 1);
+  int64_t grain = cpu::grain_size(stride);
+  int64_t n_blocks = (static_cast<int64_t>(src.size()) + stride - 1) / stride;
+  cpu::parallel_for(n_blocks, grain, [&](int64_t begin, int64_t end) {
+    ContiguousIterator in(shape, strides[0], ndim - 3);
+    ContiguousIterator out(shape, strides[1], ndim - 3);
+    in.seek(begin);
+    out.seek(begin);
+    for (int64_t i = begin; i < end; i++) {
+      copy_dims<SrcT, DstT, 3>(
+          src_ptr + in.loc,
+          dst_ptr + out.loc,
+          shape,
+          strides[0],
+          strides[1],
+          ndim - 3);
+      in.step();
+      out.step();
+    }
+  });
 }
 
 template <typename SrcT, typename DstT>
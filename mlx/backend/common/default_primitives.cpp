@@ -4,6 +4,7 @@
 
 #include "mlx/array.h"
 #include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/gemm.h"
 #include "mlx/backend/common/lapack.h"
 #include "mlx/backend/common/utils.h"
 #include "mlx/primitives.h"
@@ -63,6 +64,7 @@ DEFAULT(FFT)
 DEFAULT(Floor)
 DEFAULT(Full)
 DEFAULT(Gather)
+DEFAULT(GatherAxis)
 DEFAULT(Greater)
 DEFAULT(GreaterEqual)
 DEFAULT(Hadamard)
@@ -108,6 +110,7 @@ DEFAULT(Subtract)
 DEFAULT_MULTI(SVD)
 DEFAULT(Tan)
 DEFAULT(Tanh)
+DEFAULT_MULTI(TopK)
 DEFAULT(Transpose)
 DEFAULT(Inverse)
 DEFAULT(Cholesky)
@@ -172,18 +175,25 @@ inline void matmul_common_general(
 } // namespace
 
 void Matmul::eval_cpu(const std::vector<array>& inputs, array& out) {
-  if (out.dtype() != float32) {
+  out.set_data(allocator::malloc_or_wait(out.nbytes()));
+  if (out.dtype() == float32) {
+    return matmul_common_general(inputs[0], inputs[1], out);
+  }
+  if (out.dtype() != float16 && out.dtype() != bfloat16 &&
+      out.dtype() != int32) {
     throw std::runtime_error(
-        "[Matmul::eval_cpu] Currently only supports float32.");
+        "[Matmul::eval_cpu] Currently only supports float32, float16, "
+        "bfloat16 and int8 inputs.");
   }
-  out.set_data(allocator::malloc_or_wait(out.nbytes()));
-  return matmul_common_general(inputs[0], inputs[1], out);
+  return gemm(inputs[0], inputs[1], out);
 }
 
 void AddMM::eval_cpu(const std::vector<array>& inputs, array& out) {
-  if (out.dtype() != float32) {
+  if (out.dtype() != float32 && out.dtype() != float16 &&
+      out.dtype() != bfloat16) {
     throw std::runtime_error(
-        "[AddMM::eval_cpu] Currently only supports float32.");
+        "[AddMM::eval_cpu] Currently only supports float32, float16 and "
+        "bfloat16.");
   }
 
   // Fill output with C
@@ -191,7 +201,10 @@ void AddMM::eval_cpu(const std::vector<array>& inputs, array& out) {
   CopyType ctype = c.data_size() == 1 ? CopyType::Scalar : CopyType::General;
   copy(c, out, ctype);
 
-  return matmul_common_general(inputs[0], inputs[1], out, alpha_, beta_);
+  if (out.dtype() == float32) {
+    return matmul_common_general(inputs[0], inputs[1], out, alpha_, beta_);
+  }
+  return gemm(inputs[0], inputs[1], out, alpha_, beta_);
 }
 
 } // namespace mlx::core
@@ -1,9 +1,11 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
 #include <numeric>
 
 #include "mlx/3rdparty/pocketfft.h"
 #include "mlx/allocator.h"
+#include "mlx/backend/common/parallel.h"
 #include "mlx/primitives.h"
 
 namespace mlx::core {
@@ -38,46 +40,85 @@ void FFT::eval(const std::vector<array>& inputs, array& out) {
         });
     scale /= nelem;
   }
+  // Split the batch along the largest axis which is not transformed. Each
+  // block is a separate pocketfft call on one thread of the intra-op pool,
+  // the plans are shared through pocketfft's cache.
+  int batch_axis = -1;
+  for (int i = 0; i < shape.size(); i++) {
+    if (std::find(axes_.begin(), axes_.end(), i) == axes_.end() &&
+        (batch_axis < 0 || shape[i] > shape[batch_axis])) {
+      batch_axis = i;
+    }
+  }
+  auto parallel_fft = [&](auto in_ptr, auto out_ptr, auto fft) {
+    if (batch_axis < 0) {
+      fft(shape, in_ptr, out_ptr);
+      return;
+    }
+    size_t batch_size = shape[batch_axis];
+    auto grain = cpu::grain_size(
+        std::accumulate(
+            shape.begin(), shape.end(), size_t(1), std::multiplies<>()) /
+        batch_size);
+    cpu::parallel_for(batch_size, grain, [&](int64_t begin, int64_t end) {
+      auto block_shape = shape;
+      block_shape[batch_axis] = end - begin;
+      fft(block_shape,
+          reinterpret_cast<decltype(in_ptr)>(
+              reinterpret_cast<const char*>(in_ptr) +
+              begin * strides_in[batch_axis]),
+          reinterpret_cast<decltype(out_ptr)>(
+              reinterpret_cast<char*>(out_ptr) +
+              begin * strides_out[batch_axis]));
+    });
+  };
+
   if (in.dtype() == complex64 && out.dtype() == complex64) {
     auto in_ptr =
         reinterpret_cast<const std::complex<float>*>(in.data<complex64_t>());
     auto out_ptr =
         reinterpret_cast<std::complex<float>*>(out.data<complex64_t>());
-    pocketfft::c2c(
-        shape,
-        strides_in,
-        strides_out,
-        axes_,
-        !inverse_,
-        in_ptr,
-        out_ptr,
-        scale);
+    parallel_fft(in_ptr, out_ptr, [&](auto& shape, auto in_ptr, auto out_ptr) {
+      pocketfft::c2c(
+          shape,
+          strides_in,
+          strides_out,
+          axes_,
+          !inverse_,
+          in_ptr,
+          out_ptr,
+          scale);
+    });
   } else if (in.dtype() == float32 && out.dtype() == complex64) {
     auto in_ptr = in.data<float>();
     auto out_ptr =
         reinterpret_cast<std::complex<float>*>(out.data<complex64_t>());
-    pocketfft::r2c(
-        shape,
-        strides_in,
-        strides_out,
-        axes_,
-        !inverse_,
-        in_ptr,
-        out_ptr,
-        scale);
+    parallel_fft(in_ptr, out_ptr, [&](auto& shape, auto in_ptr, auto out_ptr) {
+      pocketfft::r2c(
+          shape,
+          strides_in,
+          strides_out,
+          axes_,
+          !inverse_,
+          in_ptr,
+          out_ptr,
+          scale);
+    });
   } else if (in.dtype() == complex64 && out.dtype() == float32) {
     auto in_ptr =
         reinterpret_cast<const std::complex<float>*>(in.data<complex64_t>());
     auto out_ptr = out.data<float>();
-    pocketfft::c2r(
-        shape,
-        strides_in,
-        strides_out,
-        axes_,
-        !inverse_,
-        in_ptr,
-        out_ptr,
-        scale);
+    parallel_fft(in_ptr, out_ptr, [&](auto& shape, auto in_ptr, auto out_ptr) {
+      pocketfft::c2r(
+          shape,
+          strides_in,
+          strides_out,
+          axes_,
+          !inverse_,
+          in_ptr,
+          out_ptr,
+          scale);
+    });
   } else {
     throw std::runtime_error(
         "[FFT] Received unexpected input and output type combination.");
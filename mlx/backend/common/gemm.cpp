@@ -0,0 +1,319 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <vector>
+
+#include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/gemm.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
+#include "mlx/backend/common/utils.h"
+
+namespace mlx::core {
+
+namespace {
+
+// Rows and columns of the output tile kept in registers by the micro kernel
+constexpr size_t MR = 4;
+constexpr size_t NR = 16;
+
+// Rows and columns of the output block computed by a single task. Both
+// operands are packed in their own type for the whole depth and converted to
+// the accumulation type KC elements deep at a time.
+constexpr size_t MC = 64;
+constexpr size_t NC = 128;
+constexpr size_t KC = 256;
+
+std::tuple<bool, size_t, array> check_transpose(const array& arr) {
+  auto stx = arr.strides()[arr.ndim() - 2];
+  auto sty = arr.strides()[arr.ndim() - 1];
+  if (stx == arr.shape(-1) && sty == 1) {
+    return std::make_tuple(false, stx, arr);
+  } else if (stx == 1 && sty == arr.shape(-2)) {
+    return std::make_tuple(true, sty, arr);
+  } else {
+    array arr_copy(arr.shape(), arr.dtype(), nullptr, {});
+    copy(arr, arr_copy, CopyType::General);
+    size_t stx = arr.shape(-1);
+    return std::make_tuple(false, stx, arr_copy);
+  }
+}
+
+// A row major matrix which is read transposed if transposed is true
+template <typename T>
+struct Matrix {
+  const T* data;
+  bool transposed;
+  size_t ld;
+
+  T operator()(size_t i, size_t j) const {
+    return transposed ? data[j * ld + i] : data[i * ld + j];
+  }
+};
+
+template <typename T, typename AccT>
+void to_acc(const T* src, AccT* dst, size_t n) {
+  if (simd::convert(src, dst, n)) {
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = static_cast<AccT>(src[i]);
+  }
+}
+
+template <typename AccT, typename OutT>
+inline OutT epilogue(AccT acc, OutT c, float alpha, float beta) {
+  if (beta == 0.0f) {
+    if (alpha == 1.0f) {
+      return static_cast<OutT>(acc);
+    }
+    return static_cast<OutT>(alpha * static_cast<float>(acc));
+  }
+  return static_cast<OutT>(
+      alpha * static_cast<float>(acc) + beta * static_cast<float>(c));
+}
+
+// c[MR, NR] += a[kc, MR]^T @ b[kc, NR]
+template <typename AccT>
+void micro_kernel(
+    const AccT* a,
+    const AccT* b,
+    size_t kc,
+    AccT* c,
+    size_t ldc) {
+  AccT acc[MR][NR] = {};
+  for (size_t k = 0; k < kc; k++) {
+    for (size_t i = 0; i < MR; i++) {
+      AccT ai = a[k * MR + i];
+      for (size_t j = 0; j < NR; j++) {
+        acc[i][j] += ai * b[k * NR + j];
+      }
+    }
+  }
+  for (size_t i = 0; i < MR; i++) {
+    for (size_t j = 0; j < NR; j++) {
+      c[i * ldc + j] += acc[i][j];
+    }
+  }
+}
+
+// Computes the [m, n] block of the output starting at (i0, j0).
+template <typename T, typename AccT, typename OutT>
+void gemm_block(
+    Matrix<T> a,
+    Matrix<T> b,
+    OutT* out,
+    size_t ldo,
+    size_t i0,
+    size_t m,
+    size_t j0,
+    size_t n,
+    size_t K,
+    float alpha,
+    float beta) {
+  size_t m_groups = (m + MR - 1) / MR;
+  size_t n_panels = (n + NR - 1) / NR;
+  size_t ldc = n_panels * NR;
+
+  // Pack a into [m_groups, K, MR] and b into [n_panels, K, NR] so that every
+  // KC deep slice the micro kernel reads is contiguous. The edges are padded
+  // with zeros.
+  std::vector<T> a_packed(m_groups * K * MR);
+  std::vector<T> b_packed(n_panels * K * NR);
+  for (size_t g = 0; g < m_groups; g++) {
+    T* dst = a_packed.data() + g * K * MR;
+    for (size_t i = 0; i < MR; i++) {
+      size_t row = g * MR + i;
+      for (size_t k = 0; k < K; k++) {
+        dst[k * MR + i] = (row < m) ? a(i0 + row, k) : T(0);
+      }
+    }
+  }
+  for (size_t p = 0; p < n_panels; p++) {
+    T* dst = b_packed.data() + p * K * NR;
+    for (size_t k = 0; k < K; k++) {
+      for (size_t j = 0; j < NR; j++) {
+        size_t col = p * NR + j;
+        dst[k * NR + j] = (col < n) ? b(k, j0 + col) : T(0);
+      }
+    }
+  }
+
+  std::vector<AccT> a_acc(m_groups * KC * MR);
+  std::vector<AccT> b_acc(KC * NR);
+  std::vector<AccT> c(m_groups * MR * ldc, AccT(0));
+  for (size_t pc = 0; pc < K; pc += KC) {
+    size_t kc = std::min(KC, K - pc);
+    for (size_t g = 0; g < m_groups; g++) {
+      to_acc(
+          a_packed.data() + (g * K + pc) * MR,
+          a_acc.data() + g * kc * MR,
+          kc * MR);
+    }
+    for (size_t p = 0; p < n_panels; p++) {
+      to_acc(b_packed.data() + (p * K + pc) * NR, b_acc.data(), kc * NR);
+      for (size_t g = 0; g < m_groups; g++) {
+        micro_kernel(
+            a_acc.data() + g * kc * MR,
+            b_acc.data(),
+            kc,
+            c.data() + g * MR * ldc + p * NR,
+            ldc);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < m; i++) {
+    OutT* dst = out + (i0 + i) * ldo + j0;
+    for (size_t j = 0; j < n; j++) {
+      dst[j] = epilogue(c[i * ldc + j], dst[j], alpha, beta);
+    }
+  }
+}
+
+// The single row case is bound by reading b so it skips the packing and
+// streams b once.
+template <typename T, typename AccT, typename OutT>
+void gemv(
+    Matrix<T> a,
+    Matrix<T> b,
+    OutT* out,
+    size_t N,
+    size_t K,
+    float alpha,
+    float beta) {
+  cpu::parallel_for(N, cpu::grain_size(K), [&](int64_t begin, int64_t end) {
+    size_t n = end - begin;
+    std::vector<AccT> x(K);
+    for (size_t k = 0; k < K; k++) {
+      x[k] = static_cast<AccT>(a(0, k));
+    }
+
+    if (b.transposed) {
+      // Every output is a dot product with a contiguous row of b
+      constexpr size_t lanes = 8;
+      std::vector<AccT> row(std::min(K, KC));
+      for (int64_t j = begin; j < end; j++) {
+        AccT partial[lanes] = {};
+        AccT acc = 0;
+        for (size_t pc = 0; pc < K; pc += KC) {
+          size_t kc = std::min(KC, K - pc);
+          to_acc(b.data + j * b.ld + pc, row.data(), kc);
+          const AccT* xk = x.data() + pc;
+          size_t k = 0;
+          for (; k + lanes <= kc; k += lanes) {
+            for (size_t l = 0; l < lanes; l++) {
+              partial[l] += xk[k + l] * row[k + l];
+            }
+          }
+          for (; k < kc; k++) {
+            acc += xk[k] * row[k];
+          }
+        }
+        for (size_t l = 0; l < lanes; l++) {
+          acc += partial[l];
+        }
+        out[j] = epilogue(acc, out[j], alpha, beta);
+      }
+    } else {
+      // Accumulate the rows of b scaled by the entries of a
+      std::vector<AccT> acc(n, AccT(0));
+      std::vector<AccT> row(n);
+      for (size_t k = 0; k < K; k++) {
+        to_acc(b.data + k * b.ld + begin, row.data(), n);
+        AccT xk = x[k];
+        for (size_t j = 0; j < n; j++) {
+          acc[j] += xk * row[j];
+        }
+      }
+      for (size_t j = 0; j < n; j++) {
+        out[begin + j] = epilogue(acc[j], out[begin + j], alpha, beta);
+      }
+    }
+  });
+}
+
+template <typename T, typename AccT, typename OutT>
+void gemm(
+    const array& a_pre,
+    const array& b_pre,
+    array& out,
+    float alpha,
+    float beta) {
+  auto [a_transposed, lda, a] = check_transpose(a_pre);
+  auto [b_transposed, ldb, b] = check_transpose(b_pre);
+  size_t M = a.shape(-2);
+  size_t N = b.shape(-1);
+  size_t K = a.shape(-1);
+  if (M == 0 || N == 0) {
+    return;
+  }
+
+  size_t batch = out.size() / (M * N);
+  size_t m_blocks = (M + MC - 1) / MC;
+  size_t n_blocks = (N + NC - 1) / NC;
+  auto a_ptr = a.data<T>();
+  auto b_ptr = b.data<T>();
+  auto out_ptr = out.data<OutT>();
+  auto matrix = [&](const T* ptr, bool transposed, size_t ld, size_t offset) {
+    return Matrix<T>{ptr + offset, transposed, ld};
+  };
+
+  if (M == 1) {
+    for (size_t i = 0; i < batch; i++) {
+      gemv<T, AccT, OutT>(
+          matrix(a_ptr, a_transposed, lda, elem_to_loc(K * i, a)),
+          matrix(b_ptr, b_transposed, ldb, elem_to_loc(K * N * i, b)),
+          out_ptr + N * i,
+          N,
+          K,
+          alpha,
+          beta);
+    }
+    return;
+  }
+
+  size_t n_tasks = batch * m_blocks * n_blocks;
+  cpu::parallel_for(n_tasks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t t = begin; t < end; t++) {
+      size_t i = t / (m_blocks * n_blocks);
+      size_t ib = (t / n_blocks) % m_blocks;
+      size_t jb = t % n_blocks;
+      gemm_block<T, AccT, OutT>(
+          matrix(a_ptr, a_transposed, lda, elem_to_loc(M * K * i, a)),
+          matrix(b_ptr, b_transposed, ldb, elem_to_loc(K * N * i, b)),
+          out_ptr + M * N * i,
+          N,
+          ib * MC,
+          std::min(MC, M - ib * MC),
+          jb * NC,
+          std::min(NC, N - jb * NC),
+          K,
+          alpha,
+          beta);
+    }
+  });
+}
+
+} // namespace
+
+void gemm(
+    const array& a,
+    const array& b,
+    array& out,
+    float alpha /* = 1.0f */,
+    float beta /* = 0.0f */) {
+  switch (a.dtype()) {
+    case float16:
+      return gemm<float16_t, float, float16_t>(a, b, out, alpha, beta);
+    case bfloat16:
+      return gemm<bfloat16_t, float, bfloat16_t>(a, b, out, alpha, beta);
+    case int8:
+      return gemm<int8_t, int32_t, int32_t>(a, b, out, alpha, beta);
+    default:
+      throw std::runtime_error(
+          "[gemm] Only float16, bfloat16 and int8 are supported.");
+  }
+}
+
+} // namespace mlx::core
@@ -0,0 +1,22 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include "mlx/array.h"
+
+namespace mlx::core {
+
+// Computes out = alpha * (a @ b) + beta * out over the last two dimensions
+// of a and b without going through BLAS.
+//
+// Supports float16 and bfloat16 inputs which are accumulated in float32 and
+// int8 inputs which are accumulated exactly in int32 (out must be int32).
+// The output must be allocated and, if beta is not 0, hold the addend.
+void gemm(
+    const array& a,
+    const array& b,
+    array& out,
+    float alpha = 1.0f,
+    float beta = 0.0f);
+
+} // namespace mlx::core
@@ -0,0 +1,301 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "mlx/backend/common/graph_executor.h"
+#include "mlx/backend/common/threading.h"
+
+namespace mlx::core::cpu {
+
+namespace {
+
+// The state of a single call to run_graph. Every participating thread owns a
+// slot with a queue of ready nodes. A thread pushes the nodes it makes ready to
+// its own queue and runs them last in first out, so a consumer usually runs
+// right after its producer while the data is still in cache. Threads with an
+// empty queue steal the oldest node from the other ones.
+class GraphRun {
+ public:
+  GraphRun(
+      const std::vector<std::vector<int>>& consumers,
+      const std::vector<int>& n_deps,
+      const std::function<void(int)>& fn,
+      int n_slots)
+      : consumers_(consumers),
+        fn_(fn),
+        deps_(new std::atomic<int>[n_deps.size()]),
+        queues_(n_slots),
+        remaining_(n_deps.size()) {
+    for (int i = 0; i < n_deps.size(); i++) {
+      deps_[i].store(n_deps[i], std::memory_order_relaxed);
+    }
+  }
+
+  void push(int slot, int node) {
+    auto& q = queues_[slot];
+    {
+      std::lock_guard<std::mutex> lk(q.mtx);
+      q.nodes.push_back(node);
+    }
+    n_queued_.fetch_add(1, std::memory_order_release);
+  }
+
+  bool pop(int slot, int& node) {
+    if (n_queued_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    int n_slots = queues_.size();
+    for (int k = 0; k < n_slots; k++) {
+      auto& q = queues_[(slot + k) % n_slots];
+      std::lock_guard<std::mutex> lk(q.mtx);
+      if (q.nodes.empty()) {
+        continue;
+      }
+      if (k == 0) {
+        node = q.nodes.back();
+        q.nodes.pop_back();
+      } else {
+        node = q.nodes.front();
+        q.nodes.pop_front();
+      }
+      n_queued_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  // Run a node and queue the consumers it makes ready. Returns how many were
+  // queued.
+  int execute(int slot, int node) {
+    if (!failed_.load(std::memory_order_relaxed)) {
+      try {
+        fn_(node);
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+        failed_ = true;
+      }
+    }
+    int n_ready = 0;
+    for (int c : consumers_[node]) {
+      if (deps_[c].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        push(slot, c);
+        n_ready++;
+      }
+    }
+    // Nothing of the run may be touched after the last node is done since the
+    // caller is then free to return
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lk(mtx_);
+      cond_.notify_all();
+    }
+    return n_ready;
+  }
+
+  bool has_work() const {
+    return n_queued_.load(std::memory_order_acquire) > 0;
+  }
+
+  bool done() const {
+    return remaining_.load(std::memory_order_acquire) == 0;
+  }
+
+  // Wake the caller if it is waiting for work
+  void notify() {
+    { std::lock_guard<std::mutex> lk(mtx_); }
+    cond_.notify_all();
+  }
+
+  // Wait until there is work to steal or all the nodes are done
+  void wait() {
+    std::unique_lock<std::mutex> lk(mtx_);
+    cond_.wait(lk, [this] { return done() || has_work(); });
+  }
+
+  void rethrow() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ private:
+  struct Queue {
+    std::mutex mtx;
+    std::deque<int> nodes;
+  };
+
+  const std::vector<std::vector<int>>& consumers_;
+  const std::function<void(int)>& fn_;
+  std::unique_ptr<std::atomic<int>[]> deps_;
+  std::vector<Queue> queues_;
+  std::atomic<int> n_queued_{0};
+  std::atomic<int> remaining_;
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+  std::mutex mtx_;
+  std::condition_variable cond_;
+};
+
+// Workers which join the graph runs in progress whenever they have nodes
+// ready to run. Worker i uses slot i + 1 in the runs and the caller slot 0.
+class GraphPool {
+ public:
+  explicit GraphPool(int n_threads) : stop_(false) {
+    for (int i = 1; i < n_threads; i++) {
+      workers_.emplace_back(&GraphPool::thread_fn, this, i);
+    }
+  }
+
+  ~GraphPool() {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto& w : workers_) {
+      w.join();
+    }
+  }
+
+  // Not copyable or moveable
+  GraphPool(const GraphPool&) = delete;
+  GraphPool(GraphPool&&) = delete;
+  GraphPool& operator=(const GraphPool&) = delete;
+  GraphPool& operator=(GraphPool&&) = delete;
+
+  int size() const {
+    return workers_.size() + 1;
+  }
+
+  void add(const std::shared_ptr<GraphRun>& run) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    runs_.push_back(run);
+  }
+
+  void remove(const std::shared_ptr<GraphRun>& run) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    runs_.erase(std::find(runs_.begin(), runs_.end(), run));
+  }
+
+  // Wake up to n idle workers
+  void notify(int n) {
+    { std::lock_guard<std::mutex> lk(mtx_); }
+    if (n >= static_cast<int>(workers_.size())) {
+      cond_.notify_all();
+    } else {
+      for (int i = 0; i < n; i++) {
+        cond_.notify_one();
+      }
+    }
+  }
+
+  // Run the nodes of a run from the given slot until none are ready
+  void work(GraphRun& run, int slot) {
+    int node;
+    while (run.pop(slot, node)) {
+      if (int n_ready = run.execute(slot, node); n_ready > 1) {
+        notify(n_ready - 1);
+        run.notify();
+      }
+    }
+  }
+
+ private:
+  void thread_fn(int slot) {
+    while (true) {
+      std::shared_ptr<GraphRun> run;
+      {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cond_.wait(lk, [this, &run] {
+          if (stop_) {
+            return true;
+          }
+          for (auto& r : runs_) {
+            if (r->has_work()) {
+              run = r;
+              return true;
+            }
+          }
+          return false;
+        });
+        if (stop_) {
+          return;
+        }
+      }
+      work(*run, slot);
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::vector<std::shared_ptr<GraphRun>> runs_;
+  std::mutex mtx_;
+  std::condition_variable cond_;
+  bool stop_;
+};
+
+struct PoolHolder {
+  std::mutex mtx;
+  std::shared_ptr<GraphPool> pool;
+};
+
+std::shared_ptr<GraphPool> get_pool() {
+  static PoolHolder holder;
+  std::lock_guard<std::mutex> lk(holder.mtx);
+  int n_threads = get_num_threads();
+  if (!holder.pool || holder.pool->size() != n_threads) {
+    holder.pool = std::make_shared<GraphPool>(n_threads);
+  }
+  return holder.pool;
+}
+
+} // namespace
+
+void run_graph(
+    const std::vector<std::vector<int>>& consumers,
+    std::vector<int> n_deps,
+    const std::function<void(int)>& fn) {
+  int n_nodes = n_deps.size();
+  if (n_nodes <= 1 || get_num_threads() <= 1) {
+    for (int i = 0; i < n_nodes; i++) {
+      fn(i);
+    }
+    return;
+  }
+
+  auto pool = get_pool();
+  auto run = std::make_shared<GraphRun>(consumers, n_deps, fn, pool->size());
+
+  // Queue the roots so that the first one in order is the first to run
+  int n_ready = 0;
+  for (int i = n_nodes - 1; i >= 0; i--) {
+    if (n_deps[i] == 0) {
+      run->push(0, i);
+      n_ready++;
+    }
+  }
+
+  pool->add(run);
+  if (n_ready > 1) {
+    pool->notify(n_ready - 1);
+  }
+  while (true) {
+    pool->work(*run, 0);
+    run->wait();
+    if (run->done()) {
+      break;
+    }
+  }
+  pool->remove(run);
+  run->rethrow();
+}
+
+} // namespace mlx::core::cpu
@@ -0,0 +1,28 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace mlx::core::cpu {
+
+/* Run the nodes of a dependency graph, calling fn(i) for each node once all
+ * the nodes it depends on are done.
+ *
+ * consumers[i] lists the nodes which depend on node i, once per dependency,
+ * and n_deps[i] is the number of dependencies of node i. Nodes that are ready
+ * at the same time run in parallel on a work stealing pool. The calling
+ * thread takes part in the work and the call returns once all the nodes are
+ * done. If fn throws, the remaining nodes are skipped and the first exception
+ * is rethrown on the calling thread.
+ *
+ * The nodes must be given in a valid sequential order which is followed when
+ * only a single thread is available.
+ * */
+void run_graph(
+    const std::vector<std::vector<int>>& consumers,
+    std::vector<int> n_deps,
+    const std::function<void(int)>& fn);
+
+} // namespace mlx::core::cpu
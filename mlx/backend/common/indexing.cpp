@@ -7,6 +7,7 @@
 #include "mlx/primitives.h"
 
 #include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/parallel.h"
 #include "mlx/backend/common/utils.h"
 
 namespace mlx::core {
@@ -78,38 +79,48 @@ void gather(
   size_t ind_size = slice_size == 0 ? 0 : out.size() / slice_size;
   const T* src_ptr = src.data<T>();
   T* dst_ptr = out.data<T>();
-  size_t out_idx = 0;
 
-  std::vector<ContiguousIterator> its(inds.begin(), inds.end());
-  ContiguousIterator src_it;
-  if (!can_copy && src.ndim() > 0) {
-    src_it = ContiguousIterator(slice_sizes, src.strides(), src.ndim());
-  }
-  for (int idx = 0; idx < ind_size; idx++) {
-    size_t src_idx = 0;
-    for (int ii = 0; ii < inds.size(); ++ii) {
-      auto ax = axes[ii];
-      auto idx_loc = its[ii].loc;
-      its[ii].step();
-      auto idx_val =
-          offset_neg_idx(inds[ii].data<IdxT>()[idx_loc], src.shape(ax));
-      src_idx += (idx_val * src.strides()[ax]);
+  // Each index selects a slice of the output, the indices are split across
+  // threads
+  auto gather_slices = [&](int64_t begin, int64_t end) {
+    std::vector<ContiguousIterator> its(inds.begin(), inds.end());
+    for (auto& it : its) {
+      it.seek(begin);
+    }
+    ContiguousIterator src_it;
+    if (!can_copy && src.ndim() > 0) {
+      src_it = ContiguousIterator(slice_sizes, src.strides(), src.ndim());
     }
+    size_t out_idx = begin * slice_size;
+    for (int64_t idx = begin; idx < end; idx++) {
+      size_t src_idx = 0;
+      for (int ii = 0; ii < inds.size(); ++ii) {
+        auto ax = axes[ii];
+        auto idx_loc = its[ii].loc;
+        its[ii].step();
+        auto idx_val =
+            offset_neg_idx(inds[ii].data<IdxT>()[idx_loc], src.shape(ax));
+        src_idx += (idx_val * src.strides()[ax]);
+      }
 
-    if (slice_size == 1) {
-      dst_ptr[out_idx++] = src_ptr[src_idx];
-    } else if (can_copy) {
-      std::copy(
-          src_ptr + src_idx, src_ptr + src_idx + slice_size, dst_ptr + out_idx);
-      out_idx += slice_size;
-    } else {
-      for (int jj = 0; jj < slice_size; jj++) {
-        dst_ptr[out_idx++] = src_ptr[src_idx + src_it.loc];
-        src_it.step();
+      if (slice_size == 1) {
+        dst_ptr[out_idx++] = src_ptr[src_idx];
+      } else if (can_copy) {
+        std::copy(
+            src_ptr + src_idx,
+            src_ptr + src_idx + slice_size,
+            dst_ptr + out_idx);
+        out_idx += slice_size;
+      } else {
+        for (int jj = 0; jj < slice_size; jj++) {
+          dst_ptr[out_idx++] = src_ptr[src_idx + src_it.loc];
+          src_it.step();
+        }
+        src_it.reset();
       }
-      src_it.reset();
     }
-  }
+  };
+  cpu::parallel_for(ind_size, cpu::grain_size(slice_size), gather_slices);
 }
 
 template <typename IdxT>
@@ -211,6 +222,145 @@ void Gather::eval(const std::vector<array>& inputs, array& out) {
   }
 }
 
+template <typename T, typename IdxT>
+void gather_axis(
+    const array& src,
+    const array& ind,
+    array& out,
+    const int axis) {
+  // The inputs are broadcast to the same shape except along the axis so the
+  // output is walked one row of its last dimension at a time
+  auto shape = ind.shape();
+  auto ind_strides = ind.strides();
+  auto src_strides = src.strides();
+  auto ind_ax_stride = ind_strides[axis];
+  auto src_ax_stride = src_strides[axis];
+  auto src_ax_size = src.shape(axis);
+  src_strides[axis] = 0;
+
+  int64_t row_size = shape.back();
+  auto ind_row_stride = ind_strides.back();
+  auto src_row_stride = src_strides.back();
+  shape.pop_back();
+  ind_strides.pop_back();
+  src_strides.pop_back();
+  size_t n_rows = row_size == 0 ? 0 : out.size() / row_size;
+
+  const T* src_ptr = src.data<T>();
+  const IdxT* ind_ptr = ind.data<IdxT>();
+  T* dst_ptr = out.data<T>();
+  auto gather_rows = [&](int64_t begin, int64_t end) {
+    ContiguousIterator ind_it(shape, ind_strides, shape.size());
+    ContiguousIterator src_it(shape, src_strides, shape.size());
+    ind_it.seek(begin);
+    src_it.seek(begin);
+    for (int64_t i = begin; i < end; i++) {
+      auto ind_row = ind_ptr + ind_it.loc;
+      auto src_row = src_ptr + src_it.loc;
+      auto dst_row = dst_ptr + i * row_size;
+      ind_it.step();
+      src_it.step();
+      for (int64_t j = 0; j < row_size; j++) {
+        auto idx_val =
+            offset_neg_idx(ind_row[j * ind_row_stride], src_ax_size);
+        dst_row[j] = src_row[j * src_row_stride + idx_val * src_ax_stride];
+      }
+    }
+  };
+  cpu::parallel_for(n_rows, cpu::grain_size(row_size), gather_rows);
+}
+
+template <typename IdxT>
+void dispatch_gather_axis(
+    const array& src,
+    const array& ind,
+    array& out,
+    const int axis) {
+  switch (out.dtype()) {
+    case bool_:
+      gather_axis<bool, IdxT>(src, ind, out, axis);
+      break;
+    case uint8:
+      gather_axis<uint8_t, IdxT>(src, ind, out, axis);
+      break;
+    case uint16:
+      gather_axis<uint16_t, IdxT>(src, ind, out, axis);
+      break;
+    case uint32:
+      gather_axis<uint32_t, IdxT>(src, ind, out, axis);
+      break;
+    case uint64:
+      gather_axis<uint64_t, IdxT>(src, ind, out, axis);
+      break;
+    case int8:
+      gather_axis<int8_t, IdxT>(src, ind, out, axis);
+      break;
+    case int16:
+      gather_axis<int16_t, IdxT>(src, ind, out, axis);
+      break;
+    case int32:
+      gather_axis<int32_t, IdxT>(src, ind, out, axis);
+      break;
+    case int64:
+      gather_axis<int64_t, IdxT>(src, ind, out, axis);
+      break;
+    case float16:
+      gather_axis<float16_t, IdxT>(src, ind, out, axis);
+      break;
+    case float32:
+      gather_axis<float, IdxT>(src, ind, out, axis);
+      break;
+    case bfloat16:
+      gather_axis<bfloat16_t, IdxT>(src, ind, out, axis);
+      break;
+    case complex64:
+      gather_axis<complex64_t, IdxT>(src, ind, out, axis);
+      break;
+  }
+}
+
+void GatherAxis::eval(const std::vector<array>& inputs, array& out) {
+  out.set_data(allocator::malloc_or_wait(out.nbytes()));
+
+  auto& src = inputs[0];
+  auto& inds = inputs[1];
+  switch (inds.dtype()) {
+    case uint8:
+      dispatch_gather_axis<uint8_t>(src, inds, out, axis_);
+      break;
+    case uint16:
+      dispatch_gather_axis<uint16_t>(src, inds, out, axis_);
+      break;
+    case uint32:
+      dispatch_gather_axis<uint32_t>(src, inds, out, axis_);
+      break;
+    case uint64:
+      dispatch_gather_axis<uint64_t>(src, inds, out, axis_);
+      break;
+    case int8:
+      dispatch_gather_axis<int8_t>(src, inds, out, axis_);
+      break;
+    case int16:
+      dispatch_gather_axis<int16_t>(src, inds, out, axis_);
+      break;
+    case int32:
+      dispatch_gather_axis<int32_t>(src, inds, out, axis_);
+      break;
+    case int64:
+      dispatch_gather_axis<int64_t>(src, inds, out, axis_);
+      break;
+    case bool_:
+    case float16:
+    case float32:
+    case bfloat16:
+    case complex64:
+      throw std::runtime_error(
+          "[GatherAxis::eval] Cannot gather with floating point or boolean "
+          "indices.");
+      break;
+  }
+}
+
 template <typename InT, typename IdxT, typename OpT>
 void scatter(
     const array& updates,
@@ -228,31 +378,119 @@ void scatter(
   for (auto us : update_shape) {
     update_size *= us;
   }
+  if (n_updates == 0 || update_size == 0) {
+    return;
+  }
 
-  std::vector<ContiguousIterator> its(inds.begin(), inds.end());
-  ContiguousIterator update_it(updates);
-  ContiguousIterator out_it(update_shape, out.strides(), out.ndim());
-
-  for (int i = 0; i < n_updates; ++i) {
-    size_t out_offset = 0;
-    for (int j = 0; j < nind; ++j) {
-      auto ax = axes[j];
-      auto idx_loc = its[j].loc;
-      its[j].step();
-      auto idx_val =
-          offset_neg_idx(inds[j].data<IdxT>()[idx_loc], out.shape(ax));
-      out_offset += (idx_val * out.strides()[ax]);
+  // Compute where each update goes in the output
+  std::vector<int64_t> offsets(n_updates);
+  auto compute_offsets = [&](int64_t begin, int64_t end) {
+    std::vector<ContiguousIterator> its(inds.begin(), inds.end());
+    for (auto& it : its) {
+      it.seek(begin);
     }
-    update_it.seek(i * update_size);
-    for (int j = 0; j < update_size; ++j) {
-      op(updates.data<InT>()[update_it.loc],
-         out.data<InT>() + out_offset + out_it.loc);
-      update_it.step();
-      out_it.step();
+    for (auto i = begin; i < end; ++i) {
+      int64_t out_offset = 0;
+      for (int j = 0; j < nind; ++j) {
+        auto ax = axes[j];
+        auto idx_loc = its[j].loc;
+        its[j].step();
+        auto idx_val =
+            offset_neg_idx(inds[j].data<IdxT>()[idx_loc], out.shape(ax));
+        out_offset += (idx_val * out.strides()[ax]);
+      }
+      offsets[i] = out_offset;
+    }
+  };
+  cpu::parallel_for(n_updates, cpu::grain_size(nind), compute_offsets);
+
+  // If the updates and the output are row contiguous and the update covers
+  // whole trailing rows of the output then each update is a contiguous block
+  // on both sides
+  bool contiguous_slice =
+      updates.flags().row_contiguous && out.flags().row_contiguous;
+  if (contiguous_slice) {
+    int i = 0;
+    for (; i < update_shape.size() && update_shape[i] == 1; ++i)
+      ;
+    for (i++; i < update_shape.size() && contiguous_slice; ++i) {
+      contiguous_slice = (update_shape[i] == out.shape(i));
     }
-    out_it.reset();
-    update_it.reset();
   }
+
+  auto updates_ptr = updates.data<InT>();
+  auto out_ptr = out.data<InT>();
+  auto apply_updates = [&](auto&& for_each_update) {
+    if (contiguous_slice) {
+      for_each_update([&](size_t i) {
+        auto src = updates_ptr + i * update_size;
+        auto dst = out_ptr + offsets[i];
+        for (int j = 0; j < update_size; ++j) {
+          op(src[j], dst + j);
+        }
+      });
+    } else {
+      ContiguousIterator update_it(updates);
+      ContiguousIterator out_it(update_shape, out.strides(), out.ndim());
+      for_each_update([&](size_t i) {
+        update_it.seek(i * update_size);
+        out_it.reset();
+        for (int j = 0; j < update_size; ++j) {
+          op(updates_ptr[update_it.loc], out_ptr + offsets[i] + out_it.loc);
+          update_it.step();
+          out_it.step();
+        }
+      });
+    }
+  };
+
+  // Updates landing on different offsets touch disjoint parts of the output
+  // as long as they span a single index along each indexed axis. In that case
+  // group the updates by destination so that each thread owns a range of the
+  // output, updates to the same place are still applied in order.
+  bool disjoint = true;
+  for (auto ax : axes) {
+    disjoint &= (update_shape[ax] == 1);
+  }
+  int n_buckets = cpu::get_num_threads();
+  if (!disjoint || n_buckets <= 1 ||
+      n_updates * update_size <= cpu::default_grain_size) {
+    apply_updates([&](auto&& apply) {
+      for (size_t i = 0; i < n_updates; ++i) {
+        apply(i);
+      }
+    });
+    return;
+  }
+
+  // Counting sort of the updates by bucket, stable so that the order within
+  // a bucket is the original one
+  auto out_size = static_cast<int64_t>(out.size());
+  auto bucket = [&](int64_t offset) {
+    return std::clamp<int64_t>(offset * n_buckets / out_size, 0, n_buckets - 1);
+  };
+  std::vector<size_t> bucket_starts(n_buckets + 1, 0);
+  for (auto offset : offsets) {
+    bucket_starts[bucket(offset) + 1]++;
+  }
+  for (int b = 0; b < n_buckets; ++b) {
+    bucket_starts[b + 1] += bucket_starts[b];
+  }
+  std::vector<size_t> order(n_updates);
+  {
+    auto next = bucket_starts;
+    for (size_t i = 0; i < n_updates; ++i) {
+      order[next[bucket(offsets[i])]++] = i;
+    }
+  }
+
+  cpu::parallel_for(n_buckets, 1, [&](auto begin, auto end) {
+    apply_updates([&](auto&& apply) {
+      for (auto k = bucket_starts[begin]; k < bucket_starts[end]; ++k) {
+        apply(order[k]);
+      }
+    });
+  });
 }
 
 template <typename InT, typename IdxT>
@@ -2,6 +2,9 @@
 
 #include "mlx/backend/common/jit_compiler.h"
 
+#include <cctype>
+#include <cstdio>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -9,10 +12,10 @@
 
 namespace mlx::core {
 
-#ifdef _MSC_VER
-
 namespace {
 
+#ifdef _MSC_VER
+
 // Split string into array.
 std::vector<std::string> str_split(const std::string& str, char delimiter) {
   std::vector<std::string> tokens;
@@ -92,10 +95,46 @@ const VisualStudioInfo& GetVisualStudioInfo() {
   return info;
 }
 
-} // namespace
+#else
+
+// Run a command and get the first line of its output.
+std::string exec_first_line(const std::string& cmd) {
+  std::unique_ptr<FILE, decltype(&pclose)> pipe(
+      popen(cmd.c_str(), "r"), pclose);
+  if (!pipe) {
+    return "";
+  }
+  char buffer[256];
+  std::string ret;
+  if (fgets(buffer, sizeof(buffer), pipe.get())) {
+    ret = buffer;
+  }
+  while (!ret.empty() && std::isspace(ret.back())) {
+    ret.pop_back();
+  }
+  return ret;
+}
+
+// Target the vector extensions of the host so the kernel loops vectorize with
+// the widest registers available. The flags are part of the build command and
+// hence of the kernel cache key, so a cache shared between different machines
+// never loads a library built for an instruction set the host lacks.
+const std::string& isa_flags() {
+  static std::string flags = []() -> std::string {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return " -mavx2 -mfma";
+    }
+#endif
+    return "";
+  }();
+  return flags;
+}
 
 #endif // _MSC_VER
 
+} // namespace
+
 std::string JitCompiler::build_command(
     const std::filesystem::path& dir,
     const std::string& source_file_name,
@@ -119,10 +158,21 @@ std::string JitCompiler::build_command(
       libpaths);
 #else
   return fmt::format(
-      "g++ -std=c++17 -O3 -Wall -fPIC -shared '{0}' -o '{1}'",
+      "g++ -std=c++17 -O3 -fno-math-errno{0} -Wall -fPIC -shared '{1}' "
+      "-o '{2}'",
+      isa_flags(),
       (dir / source_file_name).string(),
       (dir / shared_lib_name).string());
 #endif
 }
 
+const std::string& JitCompiler::version() {
+#ifdef _MSC_VER
+  static std::string version = GetVisualStudioInfo().cl_exe;
+#else
+  static std::string version = exec_first_line("g++ --version 2>/dev/null");
+#endif
+  return version;
+}
+
 } // namespace mlx::core
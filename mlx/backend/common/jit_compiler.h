@@ -2,6 +2,7 @@
 #pragma once
 
 #include <filesystem>
+#include <string>
 
 namespace mlx::core {
 
@@ -12,6 +13,10 @@ class JitCompiler {
       const std::filesystem::path& dir,
       const std::string& source_file_name,
       const std::string& shared_lib_name);
+
+  // Identifies the compiler used by build_command so that cached libraries
+  // are rebuilt when it changes.
+  static const std::string& version();
 };
 
 } // namespace mlx::core
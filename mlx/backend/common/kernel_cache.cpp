@@ -0,0 +1,269 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "mlx/backend/common/jit_compiler.h"
+#include "mlx/backend/common/kernel_cache.h"
+#include "mlx/utils.h"
+
+namespace fs = std::filesystem;
+
+namespace mlx::core {
+
+namespace {
+
+constexpr int key_length = 16;
+
+// 64 bit FNV-1a which unlike std::hash is stable across builds and
+// platforms so every process computes the same key.
+uint64_t fnv1a(const std::string& s, uint64_t h = 14695981039346656037ull) {
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+std::string cache_key(const std::string& source) {
+  uint64_t h = fnv1a(JitCompiler::version());
+  h = fnv1a(JitCompiler::build_command("", "kernel.cpp", "kernel.so"), h);
+  h = fnv1a(source, h);
+  std::ostringstream key;
+  key << std::hex;
+  key.width(key_length);
+  key.fill('0');
+  key << h;
+  return key.str();
+}
+
+// A suffix for temporary files which is unique across processes
+std::string unique_suffix() {
+  static std::atomic<uint64_t> counter{0};
+  std::random_device rd;
+  std::ostringstream suffix;
+  suffix << std::hex << rd() << rd() << "-" << counter++;
+  return suffix.str();
+}
+
+std::string lib_name(const std::string& key) {
+  return "lib" + key + ".so";
+}
+
+// Returns the key if the file name is one of the cached libraries
+std::string key_of(const fs::path& lib) {
+  auto name = lib.filename().string();
+  if (name.size() != key_length + 6 || name.rfind("lib", 0) != 0 ||
+      lib.extension() != ".so") {
+    return "";
+  }
+  auto key = name.substr(3, key_length);
+  if (!std::all_of(key.begin(), key.end(), ::isxdigit)) {
+    return "";
+  }
+  return key;
+}
+
+fs::path default_directory() {
+  if (const char* dir = std::getenv("MLX_CPU_KERNEL_CACHE_DIR")) {
+    return dir;
+  }
+#ifdef _WIN32
+  if (const char* dir = std::getenv("LOCALAPPDATA")) {
+    return fs::path(dir) / "mlx" / "cpu_kernels";
+  }
+#else
+  if (const char* dir = std::getenv("XDG_CACHE_HOME")) {
+    return fs::path(dir) / "mlx" / "cpu_kernels";
+  }
+  if (const char* dir = std::getenv("HOME")) {
+    return fs::path(dir) / ".cache" / "mlx" / "cpu_kernels";
+  }
+#endif
+  return fs::temp_directory_path() / "mlx_cpu_kernels";
+}
+
+// Serializes the compilation of a kernel across processes so that workers
+// starting together compile it once. The lock is released on destruction.
+// Correctness does not depend on it since libraries are published with an
+// atomic rename.
+class FileLock {
+ public:
+  explicit FileLock(const fs::path& path) {
+#ifndef _WIN32
+    fd_ = open(path.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd_ >= 0 && flock(fd_, LOCK_EX) != 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+#endif
+  }
+
+  ~FileLock() {
+#ifndef _WIN32
+    if (fd_ >= 0) {
+      flock(fd_, LOCK_UN);
+      close(fd_);
+    }
+#endif
+  }
+
+  FileLock(const FileLock&) = delete;
+  FileLock& operator=(const FileLock&) = delete;
+
+ private:
+  int fd_{-1};
+};
+
+} // namespace
+
+KernelCache& KernelCache::instance() {
+  static KernelCache cache;
+  return cache;
+}
+
+KernelCache::KernelCache()
+    : max_size_(uint64_t(std::max(env::cpu_kernel_cache_size(), 0)) << 20),
+      persistent_(max_size_ > 0) {
+  std::error_code ec;
+  if (persistent_) {
+    dir_ = default_directory();
+    fs::create_directories(dir_, ec);
+    persistent_ = !ec;
+  }
+  if (!persistent_) {
+    dir_ = fs::temp_directory_path() / ("mlx_cpu_kernels_" + unique_suffix());
+    fs::create_directories(dir_, ec);
+  }
+}
+
+KernelCache::~KernelCache() {
+  if (!persistent_) {
+    std::error_code ec;
+    fs::remove_all(dir_, ec);
+  }
+}
+
+fs::path KernelCache::get(const std::string& name, const std::string& source) {
+  auto key = cache_key(source);
+  auto lib = dir_ / lib_name(key);
+
+  // Mark the library as recently used so that it is evicted last
+  auto lookup = [&lib]() {
+    std::error_code ec;
+    if (!fs::exists(lib, ec)) {
+      return false;
+    }
+    fs::last_write_time(lib, fs::file_time_type::clock::now(), ec);
+    return true;
+  };
+  if (lookup()) {
+    return lib;
+  }
+
+  FileLock lock(dir_ / (key + ".lock"));
+  if (lookup()) {
+    return lib;
+  }
+
+  // Compile to temporary files and publish the library with a rename so that
+  // other processes never see a partially written one
+  auto tmp = key + "." + unique_suffix();
+  auto source_file_name = tmp + ".cpp";
+  auto tmp_lib_name = lib_name(tmp);
+  {
+    std::ofstream source_file(dir_ / source_file_name);
+    source_file << source;
+  }
+  std::string command =
+      JitCompiler::build_command(dir_, source_file_name, tmp_lib_name);
+  auto return_code = system(command.c_str());
+  std::error_code ec;
+  fs::remove(dir_ / source_file_name, ec);
+  if (return_code) {
+    fs::remove(dir_ / tmp_lib_name, ec);
+    std::ostringstream msg;
+    msg << "[Compile::eval_cpu] Failed to compile function " << name
+        << " with error code " << return_code << "." << std::endl;
+    throw std::runtime_error(msg.str());
+  }
+  fs::rename(dir_ / tmp_lib_name, lib, ec);
+  if (ec) {
+    fs::remove(dir_ / tmp_lib_name, ec);
+    if (!fs::exists(lib, ec)) {
+      std::ostringstream msg;
+      msg << "[Compile::eval_cpu] Failed to add function " << name
+          << " to the kernel cache in " << dir_ << ".";
+      throw std::runtime_error(msg.str());
+    }
+  }
+
+  if (persistent_) {
+    evict(lib);
+  }
+  return lib;
+}
+
+void KernelCache::remove(const fs::path& lib) {
+  std::error_code ec;
+  fs::remove(lib, ec);
+}
+
+void KernelCache::evict(const fs::path& keep) {
+  struct Entry {
+    fs::path path;
+    uint64_t size;
+    fs::file_time_type time;
+  };
+  std::vector<Entry> entries;
+  uint64_t total = 0;
+  std::error_code ec;
+  for (auto it = fs::directory_iterator(dir_, ec); !ec && it != end(it);
+       it.increment(ec)) {
+    if (key_of(it->path()).empty() || it->path() == keep) {
+      continue;
+    }
+    std::error_code entry_ec;
+    uint64_t size = it->file_size(entry_ec);
+    auto time = it->last_write_time(entry_ec);
+    if (entry_ec) {
+      continue;
+    }
+    entries.push_back({it->path(), size, time});
+    total += size;
+  }
+  if (auto size = fs::file_size(keep, ec); !ec) {
+    total += size;
+  }
+  if (total <= max_size_) {
+    return;
+  }
+
+  // Removing a library another process has loaded is fine, it keeps its
+  // mapping and the next process to need it compiles it again
+  std::sort(entries.begin(), entries.end(), [](auto& a, auto& b) {
+    return a.time < b.time;
+  });
+  for (auto& e : entries) {
+    if (total <= max_size_) {
+      break;
+    }
+    fs::remove(e.path, ec);
+    fs::remove(dir_ / (key_of(e.path) + ".lock"), ec);
+    total -= e.size;
+  }
+}
+
+} // namespace mlx::core
@@ -0,0 +1,49 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace mlx::core {
+
+// A directory of compiled CPU kernels shared by all the processes using it.
+// Libraries are keyed on a hash of their source, the compiler and its flags
+// so a stale library is never loaded. Once the directory grows past its size
+// limit the least recently used libraries are removed.
+//
+// The directory is MLX_CPU_KERNEL_CACHE_DIR if set and mlx/cpu_kernels in
+// the user cache directory otherwise. The size limit in megabytes is
+// MLX_CPU_KERNEL_CACHE_SIZE. Setting it to 0 builds the kernels in a
+// temporary directory private to the process which is removed at exit.
+class KernelCache {
+ public:
+  static KernelCache& instance();
+
+  // Return the path of the library compiled from source, compiling it first
+  // if it is not in the cache. The name is only used in error messages.
+  std::filesystem::path get(
+      const std::string& name,
+      const std::string& source);
+
+  // Remove a library, for instance one that failed to load, so that the next
+  // call to get compiles it again.
+  void remove(const std::filesystem::path& lib);
+
+  const std::filesystem::path& directory() const {
+    return dir_;
+  }
+
+ private:
+  KernelCache();
+  ~KernelCache();
+
+  void evict(const std::filesystem::path& keep);
+
+  std::filesystem::path dir_;
+  uint64_t max_size_;
+  bool persistent_;
+};
+
+} // namespace mlx::core
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <utility>
 
 #include "mlx/allocator.h"
 #include "mlx/backend/common/load.h"
+#include "mlx/backend/metal/metal.h"
 #include "mlx/primitives.h"
 
 namespace {
@@ -51,8 +53,46 @@ void load(
   }
 }
 
+namespace {
+
+// Back out with the pages of a mapped file instead of reading it. Returns
+// false if the data could not be mapped.
+//
+// The CPU allocator keeps the size of a buffer in the word before its data
+// (see allocator::Buffer::raw_ptr). The mapping starts at least a word early
+// and that word is overwritten with the size which only touches a private
+// copy of the first page.
+bool load_mapped(array& out, size_t offset, io::MappedFileReader& reader) {
+  auto region = reader.map(offset, out.nbytes(), sizeof(size_t));
+  if (region.data == nullptr) {
+    return false;
+  }
+  if (reinterpret_cast<uintptr_t>(region.data) % out.itemsize() != 0) {
+    io::MappedFileReader::unmap(region);
+    return false;
+  }
+  size_t size = out.nbytes();
+  char* header = region.data - sizeof(size_t);
+  std::memcpy(header, &size, sizeof(size_t));
+  out.set_data(allocator::Buffer{header}, [region](allocator::Buffer) {
+    io::MappedFileReader::unmap(region);
+  });
+  return true;
+}
+
+} // namespace
+
 void Load::eval(const std::vector<array>& inputs, array& out) {
   assert(inputs.size() == 0);
+
+  // Metal buffers cannot wrap arbitrary file offsets so mapping is only used
+  // by the CPU allocator
+  if (auto mapped = std::dynamic_pointer_cast<io::MappedFileReader>(reader_);
+      mapped && !swap_endianness_ && !metal::is_available() &&
+      load_mapped(out, offset_, *mapped)) {
+    return;
+  }
+
   out.set_data(allocator::malloc_or_wait(out.nbytes()));
 
   load(out, offset_, reader_, swap_endianness_);
@@ -0,0 +1,149 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <atomic>
+
+#include "mlx/backend/common/memory_planner.h"
+
+namespace mlx::core::cpu {
+
+namespace {
+
+thread_local int current_node = -1;
+
+std::atomic<size_t> planned_peak_memory{0};
+
+} // namespace
+
+MemoryPlan plan_memory(
+    const std::vector<std::vector<int>>& consumers,
+    const std::vector<size_t>& sizes) {
+  int n_nodes = sizes.size();
+  MemoryPlan plan;
+  plan.slots.assign(n_nodes, -1);
+
+  // The last node which reads the output held by each slot
+  std::vector<int> slot_ends;
+  for (int i = 0; i < n_nodes; i++) {
+    size_t size = sizes[i];
+    if (size == 0) {
+      continue;
+    }
+    int end = i;
+    for (int c : consumers[i]) {
+      end = std::max(end, c);
+    }
+    plan.total += size;
+
+    // A slot is free once the last reader of its output has run. Pick the
+    // smallest free slot that fits or else the largest one and grow it.
+    int best = -1;
+    int largest = -1;
+    for (int s = 0; s < slot_ends.size(); s++) {
+      if (slot_ends[s] >= i) {
+        continue;
+      }
+      size_t slot_size = plan.slot_sizes[s];
+      if (slot_size >= size &&
+          (best < 0 || slot_size < plan.slot_sizes[best])) {
+        best = s;
+      }
+      if (largest < 0 || slot_size > plan.slot_sizes[largest]) {
+        largest = s;
+      }
+    }
+    if (best < 0) {
+      best = largest;
+    }
+    if (best < 0) {
+      best = slot_ends.size();
+      slot_ends.push_back(end);
+      plan.slot_sizes.push_back(size);
+    } else {
+      slot_ends[best] = end;
+      plan.slot_sizes[best] = std::max(plan.slot_sizes[best], size);
+    }
+    plan.slots[i] = best;
+  }
+
+  for (auto size : plan.slot_sizes) {
+    plan.peak += size;
+  }
+  return plan;
+}
+
+MemoryArena::MemoryArena(const MemoryPlan& plan) : node_slots_(plan.slots) {
+  slots_.reserve(plan.slot_sizes.size());
+  for (auto size : plan.slot_sizes) {
+    slots_.push_back({size});
+  }
+  planned_peak_memory.store(plan.peak, std::memory_order_relaxed);
+}
+
+MemoryArena::~MemoryArena() {
+  // Buffers still in use are freed by the allocator once they are released
+  for (auto& slot : slots_) {
+    if (slot.ptr == nullptr) {
+      continue;
+    }
+    allocator::unregister_pool_buffer(allocator::Buffer{slot.ptr});
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (!slot.busy) {
+      allocator::allocator().free(allocator::Buffer{slot.ptr});
+    }
+  }
+}
+
+allocator::Buffer MemoryArena::malloc(size_t size) {
+  if (size == 0 || current_node < 0 || node_slots_[current_node] < 0) {
+    return allocator::Buffer{nullptr};
+  }
+  void* ptr;
+  bool is_new = false;
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto& slot = slots_[node_slots_[current_node]];
+    if (slot.busy || size > slot.size) {
+      return allocator::Buffer{nullptr};
+    }
+    if (slot.ptr == nullptr) {
+      slot.ptr = allocator::allocator().malloc(slot.size).ptr();
+      if (slot.ptr == nullptr) {
+        return allocator::Buffer{nullptr};
+      }
+      is_new = true;
+    }
+    slot.busy = true;
+    ptr = slot.ptr;
+  }
+  if (is_new) {
+    allocator::register_pool_buffer(allocator::Buffer{ptr}, this);
+  }
+  return allocator::Buffer{ptr};
+}
+
+void MemoryArena::free(allocator::Buffer buffer) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  for (auto& slot : slots_) {
+    if (slot.ptr == buffer.ptr()) {
+      slot.busy = false;
+      return;
+    }
+  }
+}
+
+MemoryArena::NodeScope::NodeScope(MemoryArena& arena, int node)
+    : prev_(allocator::set_thread_pool(&arena)), prev_node_(current_node) {
+  current_node = node;
+}
+
+MemoryArena::NodeScope::~NodeScope() {
+  allocator::set_thread_pool(prev_);
+  current_node = prev_node_;
+}
+
+size_t get_planned_peak_memory() {
+  return planned_peak_memory.load(std::memory_order_relaxed);
+}
+
+} // namespace mlx::core::cpu
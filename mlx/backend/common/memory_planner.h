@@ -0,0 +1,84 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "mlx/allocator.h"
+
+namespace mlx::core::cpu {
+
+struct MemoryPlan {
+  // The slot of the output of each node or -1 if it is not planned
+  std::vector<int> slots;
+
+  // The size of each slot in bytes
+  std::vector<size_t> slot_sizes;
+
+  // The memory needed by the planned outputs, the sum of the slot sizes
+  size_t peak{0};
+
+  // The memory the planned outputs would need without any reuse
+  size_t total{0};
+};
+
+/* Assign the outputs of a sequence of nodes to reusable slots.
+ *
+ * The nodes are given in execution order. consumers[i] lists the nodes which
+ * read the output of node i and sizes[i] is its size in bytes, 0 for outputs
+ * which must not be planned. An output lives from its node to its last
+ * consumer and two outputs share a slot only if their lifetimes do not
+ * overlap. Slots are picked best fit and grown when none is large enough.
+ * */
+MemoryPlan plan_memory(
+    const std::vector<std::vector<int>>& consumers,
+    const std::vector<size_t>& sizes);
+
+/* The buffers of a memory plan for one evaluation.
+ *
+ * The buffer of a slot is allocated the first time it is used and handed out
+ * to the outputs planned in it. A slot only changes hands once its buffer is
+ * freed so outputs which live longer than planned, because they are donated
+ * or still referenced, are never overwritten. Their successors fall back to
+ * the allocator instead.
+ * */
+class MemoryArena : public allocator::BufferPool {
+ public:
+  explicit MemoryArena(const MemoryPlan& plan);
+  ~MemoryArena();
+
+  MemoryArena(const MemoryArena&) = delete;
+  MemoryArena& operator=(const MemoryArena&) = delete;
+
+  allocator::Buffer malloc(size_t size) override;
+  void free(allocator::Buffer buffer) override;
+
+  // Serve the allocations made by node on the calling thread while in scope
+  class NodeScope {
+   public:
+    NodeScope(MemoryArena& arena, int node);
+    ~NodeScope();
+
+   private:
+    allocator::BufferPool* prev_;
+    int prev_node_;
+  };
+
+ private:
+  struct Slot {
+    size_t size;
+    void* ptr{nullptr};
+    bool busy{false};
+  };
+
+  std::vector<int> node_slots_;
+  std::vector<Slot> slots_;
+  std::mutex mtx_;
+};
+
+// The planned peak memory of the most recent CPU evaluation in bytes
+size_t get_planned_peak_memory();
+
+} // namespace mlx::core::cpu
@@ -0,0 +1,388 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
+#include "mlx/fast_primitives.h"
+
+namespace mlx::core::fast {
+
+namespace {
+
+// Make sure that the rows are contiguous. Broadcasted rows are allowed.
+array check_input(const array& x) {
+  bool no_copy = x.flags().contiguous && x.strides()[x.ndim() - 1] == 1;
+  if (no_copy && x.ndim() > 1) {
+    auto s = x.strides()[x.ndim() - 2];
+    no_copy &= (s == 0 || s == x.shape().back());
+  }
+  if (no_copy) {
+    return x;
+  }
+  array x_copy(x.shape(), x.dtype(), nullptr, {});
+  copy(x, x_copy, CopyType::General);
+  return x_copy;
+}
+
+// The VJPs read x and the cotangent row by row in lockstep so both have to be
+// row contiguous.
+array check_row_contiguous(const array& x) {
+  if (x.flags().row_contiguous) {
+    return x;
+  }
+  array x_copy(x.shape(), x.dtype(), nullptr, {});
+  copy(x, x_copy, CopyType::General);
+  return x_copy;
+}
+
+void allocate_like(array& out, const array& x) {
+  if (x.is_donatable()) {
+    out.copy_shared_buffer(x);
+  } else {
+    out.set_data(
+        allocator::malloc_or_wait(x.data_size() * x.itemsize()),
+        x.data_size(),
+        x.strides(),
+        x.flags());
+  }
+}
+
+template <typename T>
+void to_float(const T* in, float* out, int n) {
+  if constexpr (std::is_same_v<T, float>) {
+    std::copy(in, in + n, out);
+  } else if (!simd::convert(in, out, n)) {
+    for (int i = 0; i < n; i++) {
+      out[i] = static_cast<float>(in[i]);
+    }
+  }
+}
+
+template <typename T>
+void from_float(const float* in, T* out, int n) {
+  if constexpr (std::is_same_v<T, float>) {
+    std::copy(in, in + n, out);
+  } else if (!simd::convert(in, out, n)) {
+    for (int i = 0; i < n; i++) {
+      out[i] = static_cast<T>(in[i]);
+    }
+  }
+}
+
+// Read the weight or bias of size n. Scalars have a stride of 0.
+template <typename T>
+std::vector<float> load_affine(const array& a, int n) {
+  std::vector<float> out(n);
+  const T* ptr = a.data<T>();
+  int64_t stride = (a.ndim() == 1) ? a.strides()[0] : 0;
+  for (int i = 0; i < n; i++) {
+    out[i] = static_cast<float>(ptr[i * stride]);
+  }
+  return out;
+}
+
+// Sum f(i) for i in [0, n) with independent accumulators so that the loop
+// vectorizes.
+template <typename F>
+float accumulate(int n, F f) {
+  constexpr int lanes = 8;
+  float partial[lanes] = {};
+  int i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    for (int l = 0; l < lanes; l++) {
+      partial[l] += f(i + l);
+    }
+  }
+  float sum = 0;
+  for (; i < n; i++) {
+    sum += f(i);
+  }
+  for (int l = 0; l < lanes; l++) {
+    sum += partial[l];
+  }
+  return sum;
+}
+
+// Call fn(part, begin, end) for a split of [0, n_rows) in contiguous parts
+// that run in parallel. The VJPs accumulate the weight gradients of each part
+// separately and sum them at the end so the result does not depend on the
+// scheduling.
+template <typename F>
+int for_each_part(int64_t n_rows, int axis_size, F&& fn) {
+  int64_t grain = cpu::grain_size(axis_size);
+  int n_parts = std::clamp<int64_t>(
+      (n_rows + grain - 1) / grain, 1, cpu::get_num_threads());
+  int64_t rows_per_part = (n_rows + n_parts - 1) / n_parts;
+  cpu::parallel_for(n_parts, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; p++) {
+      fn(p,
+         std::min(n_rows, p * rows_per_part),
+         std::min(n_rows, (p + 1) * rows_per_part));
+    }
+  });
+  return n_parts;
+}
+
+// Sum the per part partials into out, or zero out if it is a scalar.
+template <typename T>
+void reduce_parts(const float* partials, int n_parts, array& out) {
+  out.set_data(allocator::malloc_or_wait(out.nbytes()));
+  T* out_ptr = out.data<T>();
+  if (out.ndim() == 0) {
+    out_ptr[0] = T(0);
+    return;
+  }
+  int n = out.size();
+  for (int i = 0; i < n; i++) {
+    float sum = 0;
+    for (int p = 0; p < n_parts; p++) {
+      sum += partials[p * n + i];
+    }
+    out_ptr[i] = static_cast<T>(sum);
+  }
+}
+
+template <typename T>
+void rms_norm(const array& x, const array& w, array& out, float eps) {
+  const int D = x.shape().back();
+  const int64_t n_rows = x.data_size() / D;
+  const T* x_ptr = x.data<T>();
+  T* out_ptr = out.data<T>();
+  auto wf = load_affine<T>(w, D);
+
+  cpu::parallel_for(
+      n_rows, cpu::grain_size(D), [&](int64_t begin, int64_t end) {
+        std::vector<float> xf(D);
+        for (int64_t r = begin; r < end; r++) {
+          to_float(x_ptr + r * D, xf.data(), D);
+          float ss = accumulate(D, [&](int i) { return xf[i] * xf[i]; });
+          float n = 1.0f / std::sqrt(ss / D + eps);
+          for (int i = 0; i < D; i++) {
+            xf[i] = wf[i] * (xf[i] * n);
+          }
+          from_float(xf.data(), out_ptr + r * D, D);
+        }
+      });
+}
+
+template <typename T>
+void rms_norm_vjp(
+    const array& x,
+    const array& w,
+    const array& g,
+    array& gx,
+    array& gw,
+    float eps) {
+  const int D = x.shape().back();
+  const int64_t n_rows = x.size() / D;
+  const T* x_ptr = x.data<T>();
+  const T* g_ptr = g.data<T>();
+  T* gx_ptr = gx.data<T>();
+  auto wf = load_affine<T>(w, D);
+
+  std::vector<float> partials(cpu::get_num_threads() * D, 0.0f);
+  int n_parts =
+      for_each_part(n_rows, D, [&](int64_t p, int64_t begin, int64_t end) {
+        std::vector<float> xf(D);
+        std::vector<float> gf(D);
+        float* gw_acc = partials.data() + p * D;
+        for (int64_t r = begin; r < end; r++) {
+          to_float(x_ptr + r * D, xf.data(), D);
+          to_float(g_ptr + r * D, gf.data(), D);
+          float ss = accumulate(D, [&](int i) { return xf[i] * xf[i]; });
+          float n = 1.0f / std::sqrt(ss / D + eps);
+          float t =
+              accumulate(D, [&](int i) { return gf[i] * wf[i] * xf[i]; }) / D;
+          t *= n * n * n;
+          for (int i = 0; i < D; i++) {
+            gw_acc[i] += gf[i] * xf[i] * n;
+            xf[i] = gf[i] * wf[i] * n - xf[i] * t;
+          }
+          from_float(xf.data(), gx_ptr + r * D, D);
+        }
+      });
+  reduce_parts<T>(partials.data(), n_parts, gw);
+}
+
+template <typename T>
+void layer_norm(
+    const array& x,
+    const array& w,
+    const array& b,
+    array& out,
+    float eps) {
+  const int D = x.shape().back();
+  const int64_t n_rows = x.data_size() / D;
+  const T* x_ptr = x.data<T>();
+  T* out_ptr = out.data<T>();
+  auto wf = load_affine<T>(w, D);
+  auto bf = load_affine<T>(b, D);
+
+  cpu::parallel_for(
+      n_rows, cpu::grain_size(D), [&](int64_t begin, int64_t end) {
+        std::vector<float> xf(D);
+        for (int64_t r = begin; r < end; r++) {
+          to_float(x_ptr + r * D, xf.data(), D);
+          float mean = accumulate(D, [&](int i) { return xf[i]; }) / D;
+          for (int i = 0; i < D; i++) {
+            xf[i] -= mean;
+          }
+          float var = accumulate(D, [&](int i) { return xf[i] * xf[i]; }) / D;
+          float n = 1.0f / std::sqrt(var + eps);
+          for (int i = 0; i < D; i++) {
+            xf[i] = wf[i] * (xf[i] * n) + bf[i];
+          }
+          from_float(xf.data(), out_ptr + r * D, D);
+        }
+      });
+}
+
+template <typename T>
+void layer_norm_vjp(
+    const array& x,
+    const array& w,
+    const array& g,
+    array& gx,
+    array& gw,
+    array& gb,
+    float eps) {
+  const int D = x.shape().back();
+  const int64_t n_rows = x.size() / D;
+  const T* x_ptr = x.data<T>();
+  const T* g_ptr = g.data<T>();
+  T* gx_ptr = gx.data<T>();
+  auto wf = load_affine<T>(w, D);
+
+  // The partials of gw followed by the partials of gb
+  int max_parts = cpu::get_num_threads();
+  std::vector<float> partials(2 * max_parts * D, 0.0f);
+  int n_parts =
+      for_each_part(n_rows, D, [&](int64_t p, int64_t begin, int64_t end) {
+        std::vector<float> xf(D);
+        std::vector<float> gf(D);
+        float* gw_acc = partials.data() + p * D;
+        float* gb_acc = partials.data() + (max_parts + p) * D;
+        for (int64_t r = begin; r < end; r++) {
+          to_float(x_ptr + r * D, xf.data(), D);
+          to_float(g_ptr + r * D, gf.data(), D);
+          float mean = accumulate(D, [&](int i) { return xf[i]; }) / D;
+          for (int i = 0; i < D; i++) {
+            xf[i] -= mean;
+          }
+          float var = accumulate(D, [&](int i) { return xf[i] * xf[i]; }) / D;
+          float n = 1.0f / std::sqrt(var + eps);
+          float mean_wg =
+              accumulate(D, [&](int i) { return wf[i] * gf[i]; }) / D;
+          float mean_wgxc =
+              accumulate(D, [&](int i) { return wf[i] * gf[i] * xf[i]; }) / D;
+          float t = mean_wgxc * n * n * n;
+          for (int i = 0; i < D; i++) {
+            gw_acc[i] += gf[i] * xf[i] * n;
+            gb_acc[i] += gf[i];
+            xf[i] = (wf[i] * gf[i] - mean_wg) * n - xf[i] * t;
+          }
+          from_float(xf.data(), gx_ptr + r * D, D);
+        }
+      });
+
+  reduce_parts<T>(partials.data(), n_parts, gw);
+  reduce_parts<T>(partials.data() + max_parts * D, n_parts, gb);
+}
+
+template <typename F>
+void dispatch_float(Dtype dtype, const char* name, F&& f) {
+  switch (dtype) {
+    case float32:
+      f(float{});
+      break;
+    case float16:
+      f(float16_t{});
+      break;
+    case bfloat16:
+      f(bfloat16_t{});
+      break;
+    default:
+      throw std::runtime_error(
+          std::string("[") + name + "::eval_cpu] Unsupported type.");
+  }
+}
+
+} // namespace
+
+void RMSNorm::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 2);
+  auto& out = outputs[0];
+  auto x = check_input(inputs[0]);
+  allocate_like(out, x);
+  if (x.size() == 0) {
+    return;
+  }
+  dispatch_float(out.dtype(), "RMSNorm", [&](auto type_tag) {
+    using T = decltype(type_tag);
+    rms_norm<T>(x, inputs[1], out, eps_);
+  });
+}
+
+void RMSNormVJP::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 3);
+  auto x = check_row_contiguous(inputs[0]);
+  auto g = check_row_contiguous(inputs[2]);
+  auto& gx = outputs[0];
+  auto& gw = outputs[1];
+  gx.set_data(allocator::malloc_or_wait(gx.nbytes()));
+  dispatch_float(gx.dtype(), "RMSNormVJP", [&](auto type_tag) {
+    using T = decltype(type_tag);
+    if (x.size() == 0) {
+      reduce_parts<T>(nullptr, 0, gw);
+      return;
+    }
+    rms_norm_vjp<T>(x, inputs[1], g, gx, gw, eps_);
+  });
+}
+
+void LayerNorm::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 3);
+  auto& out = outputs[0];
+  auto x = check_input(inputs[0]);
+  allocate_like(out, x);
+  if (x.size() == 0) {
+    return;
+  }
+  dispatch_float(out.dtype(), "LayerNorm", [&](auto type_tag) {
+    using T = decltype(type_tag);
+    layer_norm<T>(x, inputs[1], inputs[2], out, eps_);
+  });
+}
+
+void LayerNormVJP::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 4);
+  auto x = check_row_contiguous(inputs[0]);
+  auto g = check_row_contiguous(inputs[3]);
+  auto& gx = outputs[0];
+  auto& gw = outputs[1];
+  auto& gb = outputs[2];
+  gx.set_data(allocator::malloc_or_wait(gx.nbytes()));
+  dispatch_float(gx.dtype(), "LayerNormVJP", [&](auto type_tag) {
+    using T = decltype(type_tag);
+    if (x.size() == 0) {
+      reduce_parts<T>(nullptr, 0, gw);
+      reduce_parts<T>(nullptr, 0, gb);
+      return;
+    }
+    layer_norm_vjp<T>(x, inputs[1], g, gx, gw, gb, eps_);
+  });
+}
+
+} // namespace mlx::core::fast
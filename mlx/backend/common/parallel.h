@@ -0,0 +1,60 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+#include "mlx/backend/common/threading.h"
+
+namespace mlx::core::cpu {
+
+// The default minimum number of elements a single task should process. Below
+// this the cost of waking up a worker dominates so the work stays on the
+// calling thread.
+constexpr int64_t default_grain_size = 32768;
+
+// The grain size in items when each item covers item_size elements.
+inline int64_t grain_size(int64_t item_size) {
+  return std::max<int64_t>(
+      default_grain_size / std::max<int64_t>(item_size, 1), 1);
+}
+
+// Run fn(i) for i in [0, n_tasks) on the intra-op pool. The calling thread
+// runs tasks as well and the call returns once all of them are done. The first
+// exception thrown by a task is rethrown on the calling thread.
+void parallel_for_impl(int64_t n_tasks, const std::function<void(int64_t)>& fn);
+
+// Returns true if called from one of the intra-op pool workers.
+bool in_parallel_region();
+
+// Split [0, size) into contiguous blocks of at least grain elements and call
+// fn(begin, end) for each of them, possibly in parallel.
+template <typename F>
+void parallel_for(int64_t size, int64_t grain, F&& fn) {
+  if (size <= 0) {
+    return;
+  }
+  grain = std::max<int64_t>(grain, 1);
+  int64_t n_tasks =
+      std::min<int64_t>(get_num_threads(), (size + grain - 1) / grain);
+  if (n_tasks <= 1 || in_parallel_region()) {
+    fn(int64_t(0), size);
+    return;
+  }
+  int64_t block = (size + n_tasks - 1) / n_tasks;
+  n_tasks = (size + block - 1) / block;
+  parallel_for_impl(n_tasks, [&](int64_t i) {
+    int64_t begin = i * block;
+    int64_t end = std::min(begin + block, size);
+    fn(begin, end);
+  });
+}
+
+template <typename F>
+void parallel_for(int64_t size, F&& fn) {
+  parallel_for(size, default_grain_size, std::forward<F>(fn));
+}
+
+} // namespace mlx::core::cpu
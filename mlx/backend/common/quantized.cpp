@@ -1,9 +1,12 @@
 // Copyright © 2023 Apple Inc.
 
 #include <cassert>
+#include <numeric>
 
 #include "mlx/backend/common/copy.h"
 #include "mlx/backend/common/ops.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
 #include "mlx/fast_primitives.h"
 #include "mlx/primitives.h"
 #include "mlx/utils.h"
@@ -12,28 +15,71 @@ namespace mlx::core {
 
 namespace {
 
-template <typename T, int bits>
-void extract_bits(const uint8_t* w_in, T* w_out) {
-  assert(bits == 3 || bits == 6);
-  if (bits == 3) {
-    w_out[0] = static_cast<T>(w_in[0] & 0x7);
-    w_out[1] = static_cast<T>((w_in[0] & 0x38) >> 3);
-    w_out[2] = static_cast<T>(((w_in[0] & 0xc0) >> 6) + ((w_in[1] & 0x1) << 2));
-    w_out[3] = static_cast<T>((w_in[1] & 0xe) >> 1);
-    w_out[4] = static_cast<T>((w_in[1] & 0x70) >> 4);
-    w_out[5] = static_cast<T>(((w_in[1] & 0x80) >> 7) + ((w_in[2] & 0x3) << 1));
-    w_out[6] = static_cast<T>((w_in[2] & 0x1c) >> 2);
-    w_out[7] = static_cast<T>((w_in[2] & 0xe0) >> 5);
-  } else if (bits == 6) {
-    w_out[0] = static_cast<T>(w_in[0] & 0x3f);
-    w_out[1] =
-        static_cast<T>(((w_in[0] >> 6) & 0x03) + ((w_in[1] & 0x0f) << 2));
-    w_out[2] =
-        static_cast<T>(((w_in[1] >> 4) & 0x0f) + ((w_in[2] & 0x03) << 4));
-    w_out[3] = static_cast<T>((w_in[2] >> 2) & 0x3f);
+// Rows of x handled by a single task. The packed weights are unpacked once
+// per block of rows so larger blocks amortize the unpacking better.
+constexpr int qmm_block_m = 32;
+
+// Columns of the output handled by a single task of the non transposed
+// kernel. It is a multiple of every supported group size.
+constexpr int qmm_block_n = 256;
+
+template <int bits>
+struct Packing {
+  static constexpr int pack_factor = bits == 3 ? 8 : bits == 6 ? 4 : 8 / bits;
+  static constexpr int bytes_per_pack = (bits == 3 || bits == 6) ? 3 : 1;
+  static constexpr uint32_t bitmask = (1 << bits) - 1;
+
+  // Bytes taken by n packed values
+  static constexpr int bytes(int n) {
+    return n / pack_factor * bytes_per_pack;
+  }
+};
+
+// Unpack n quantized values, n being a multiple of the pack factor. Every
+// pack is read as a single little endian word and split with constant
+// shifts so the loop has no branches and vectorizes.
+template <int bits>
+inline void unpack(const uint8_t* w, float* out, int n) {
+  using P = Packing<bits>;
+  for (int i = 0; i < n; i += P::pack_factor, w += P::bytes_per_pack) {
+    uint32_t v = w[0];
+    if constexpr (P::bytes_per_pack == 3) {
+      v |= (static_cast<uint32_t>(w[1]) << 8) |
+          (static_cast<uint32_t>(w[2]) << 16);
+    }
+    for (int p = 0; p < P::pack_factor; p++) {
+      out[i + p] = static_cast<float>((v >> (bits * p)) & P::bitmask);
+    }
   }
 }
 
+template <typename T>
+void to_float(const T* in, float* out, size_t n) {
+  if constexpr (std::is_same_v<T, float>) {
+    std::copy(in, in + n, out);
+  } else if (!simd::convert(in, out, n)) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = static_cast<float>(in[i]);
+    }
+  }
+}
+
+template <int N>
+inline float dot(const float* a, const float* b) {
+  constexpr int lanes = 8;
+  float partial[lanes] = {};
+  for (int i = 0; i < N; i += lanes) {
+    for (int l = 0; l < lanes; l++) {
+      partial[l] += a[i + l] * b[i + l];
+    }
+  }
+  float sum = 0;
+  for (int l = 0; l < lanes; l++) {
+    sum += partial[l];
+  }
+  return sum;
+}
+
 template <typename T, int bits, int group_size>
 void _qmm(
     T* result,
@@ -44,52 +90,61 @@ void _qmm(
     int M,
     int N,
     int K) {
-  constexpr int bitmask = (1 << bits) - 1;
-  constexpr int pack_factor = bits == 3 ? 8 : bits == 6 ? 4 : 8 / bits;
-  constexpr int bytes_per_pack = (bits == 3 || bits == 6) ? 3 : 1;
-  constexpr int packs_in_group = group_size / pack_factor;
-
-  for (int m = 0; m < M; m++) {
-    const uint8_t* w_local = (const uint8_t*)w;
-    const T* scales_local = scales;
-    const T* biases_local = biases;
-
-    std::fill(result, result + N, 0);
-
-    for (int k = 0; k < K; k++) {
-      T* result_local = result;
-      T xi = *x++;
-
-      for (int n = 0; n < N; n += group_size) {
-        T scale = *scales_local++;
-        T bias = *biases_local++;
-        for (int ng = 0; ng < packs_in_group; ng++) {
-          if (bits == 3 || bits == 6) {
-            T wl[pack_factor];
-            extract_bits<T, bits>(w_local, wl);
-#pragma clang loop unroll(full)
-            for (int p = 0; p < pack_factor; p++) {
-              (*result_local++) += xi * (scale * wl[p] + bias);
+  using P = Packing<bits>;
+  int groups = N / group_size;
+  int w_row_bytes = P::bytes(N);
+
+  std::vector<float> x_float(static_cast<size_t>(M) * K);
+  to_float(x, x_float.data(), x_float.size());
+
+  int m_blocks = (M + qmm_block_m - 1) / qmm_block_m;
+  int n_blocks = (N + qmm_block_n - 1) / qmm_block_n;
+  int64_t block_work = std::min(M, qmm_block_m) * qmm_block_n * int64_t(K);
+  cpu::parallel_for(
+      int64_t(m_blocks) * n_blocks,
+      cpu::grain_size(block_work),
+      [&](int64_t begin, int64_t end) {
+        std::vector<float> acc(qmm_block_m * qmm_block_n);
+        float w_row[qmm_block_n];
+        for (int64_t t = begin; t < end; t++) {
+          int m0 = (t / n_blocks) * qmm_block_m;
+          int m1 = std::min(M, m0 + qmm_block_m);
+          int n0 = (t % n_blocks) * qmm_block_n;
+          int nb = std::min(N - n0, qmm_block_n);
+          std::fill(acc.begin(), acc.end(), 0.0f);
+
+          for (int k = 0; k < K; k++) {
+            // Dequantize the slice of row k of w
+            auto w_local = reinterpret_cast<const uint8_t*>(w) +
+                k * w_row_bytes + P::bytes(n0);
+            unpack<bits>(w_local, w_row, nb);
+            int g0 = k * groups + n0 / group_size;
+            for (int j = 0; j < nb; j += group_size) {
+              float scale = static_cast<float>(scales[g0 + j / group_size]);
+              float bias = static_cast<float>(biases[g0 + j / group_size]);
+              for (int p = 0; p < group_size; p++) {
+                w_row[j + p] = scale * w_row[j + p] + bias;
+              }
             }
-            w_local += bytes_per_pack;
-
-          } else {
-            uint8_t wi = *w_local++;
-#pragma clang loop unroll(full)
-            for (int p = 0; p < pack_factor; p++) {
-              (*result_local++) +=
-                  xi * (scale * static_cast<T>(wi & bitmask) + bias);
-              if (bits != 8) {
-                wi >>= bits;
+
+            for (int m = m0; m < m1; m++) {
+              float xi = x_float[m * K + k];
+              float* acc_local = acc.data() + (m - m0) * qmm_block_n;
+              for (int j = 0; j < nb; j++) {
+                acc_local[j] += xi * w_row[j];
               }
             }
           }
-        }
-      }
-    }
 
-    result += N;
-  }
+          for (int m = m0; m < m1; m++) {
+            const float* acc_local = acc.data() + (m - m0) * qmm_block_n;
+            T* result_local = result + m * N + n0;
+            for (int j = 0; j < nb; j++) {
+              result_local[j] = static_cast<T>(acc_local[j]);
+            }
+          }
+        }
+      });
 }
 
 template <typename T, int bits, int group_size>
@@ -102,53 +157,57 @@ void _qmm_t(
     int M,
     int N,
     int K) {
-  constexpr int bitmask = (1 << bits) - 1;
-  constexpr int pack_factor = bits == 3 ? 8 : bits == 6 ? 4 : 8 / bits;
-  constexpr int bytes_per_pack = (bits == 3 || bits == 6) ? 3 : 1;
-  constexpr int packs_in_group = group_size / pack_factor;
-
-  for (int m = 0; m < M; m++) {
-    const uint8_t* w_local = (const uint8_t*)w;
-    const T* scales_local = scales;
-    const T* biases_local = biases;
-
-    for (int n = 0; n < N; n++) {
-      const T* x_local = x;
-      T sum = 0;
-      for (int k = 0; k < K; k += group_size) {
-        T scale = *scales_local++;
-        T bias = *biases_local++;
-
-        for (int kw = 0; kw < packs_in_group; kw++) {
-          if (bits == 3 || bits == 6) {
-            T wl[pack_factor];
-            extract_bits<T, bits>(w_local, wl);
-#pragma clang loop unroll(full)
-            for (int p = 0; p < pack_factor; p++) {
-              sum += x_local[p] * (scale * wl[p] + bias);
-            }
-            w_local += bytes_per_pack;
-            x_local += pack_factor;
-
-          } else {
-            uint8_t wi = *w_local++;
-#pragma clang loop unroll(full)
-            for (int p = 0; p < pack_factor; p++) {
-              sum +=
-                  (*x_local++) * (scale * static_cast<T>(wi & bitmask) + bias);
-              if (bits != 8) {
-                wi >>= bits;
-              }
+  using P = Packing<bits>;
+  int groups = K / group_size;
+  int w_row_bytes = P::bytes(K);
+
+  // With s and b the scale and bias of a group the dot product over the group
+  // is s * dot(x, q) + b * sum(x) so the sums of x are computed once.
+  std::vector<float> x_float(static_cast<size_t>(M) * K);
+  std::vector<float> x_sums(static_cast<size_t>(M) * groups);
+  to_float(x, x_float.data(), x_float.size());
+  for (int i = 0; i < M * groups; i++) {
+    const float* x_local = x_float.data() + i * group_size;
+    x_sums[i] = std::accumulate(x_local, x_local + group_size, 0.0f);
+  }
+
+  // Tasks are (row block, column) pairs with the columns varying fastest so
+  // that for a single row, i.e. token by token decoding, the work is split
+  // over the columns of w like a matrix vector product.
+  int m_blocks = (M + qmm_block_m - 1) / qmm_block_m;
+  int64_t column_work = std::min(M, qmm_block_m) * int64_t(K);
+  cpu::parallel_for(
+      int64_t(m_blocks) * N,
+      cpu::grain_size(column_work),
+      [&](int64_t begin, int64_t end) {
+        float q[group_size];
+        float acc[qmm_block_m];
+        for (int64_t t = begin; t < end; t++) {
+          int m0 = (t / N) * qmm_block_m;
+          int m1 = std::min(M, m0 + qmm_block_m);
+          int n = t % N;
+          std::fill(acc, acc + qmm_block_m, 0.0f);
+
+          auto w_local = reinterpret_cast<const uint8_t*>(w) + n * w_row_bytes;
+          const T* scales_local = scales + n * groups;
+          const T* biases_local = biases + n * groups;
+          for (int g = 0; g < groups; g++) {
+            unpack<bits>(w_local, q, group_size);
+            w_local += P::bytes(group_size);
+            float scale = static_cast<float>(scales_local[g]);
+            float bias = static_cast<float>(biases_local[g]);
+            for (int m = m0; m < m1; m++) {
+              const float* x_local = x_float.data() + m * K + g * group_size;
+              acc[m - m0] += scale * dot<group_size>(x_local, q) +
+                  bias * x_sums[m * groups + g];
             }
           }
-        }
-      }
-      *result = sum;
-      result++;
-    }
 
-    x += K;
-  }
+          for (int m = m0; m < m1; m++) {
+            result[m * N + n] = static_cast<T>(acc[m - m0]);
+          }
+        }
+      });
 }
 
 template <typename T, int bits, int group_size>
@@ -268,8 +327,8 @@ void _qmm_dispatch(
             M,
             N,
             K,
-            bits,
             group_size,
+            bits,
             transposed_w);
         break;
       case float16:
@@ -282,8 +341,8 @@ void _qmm_dispatch(
             M,
             N,
             K,
-            bits,
             group_size,
+            bits,
             transposed_w);
         break;
       case bfloat16:
@@ -296,8 +355,8 @@ void _qmm_dispatch(
             M,
             N,
             K,
-            bits,
             group_size,
+            bits,
             transposed_w);
         break;
       default:
@@ -343,8 +402,8 @@ void _bs_qmm_dispatch(
             M,
             N,
             K,
-            bits,
             group_size,
+            bits,
             transposed_w);
         break;
       case float16:
@@ -357,8 +416,8 @@ void _bs_qmm_dispatch(
             M,
             N,
             K,
-            bits,
             group_size,
+            bits,
             transposed_w);
         break;
       case bfloat16:
@@ -371,8 +430,8 @@ void _bs_qmm_dispatch(
             M,
             N,
             K,
-            bits,
             group_size,
+            bits,
             transposed_w);
         break;
       default:
@@ -408,7 +467,7 @@ void QuantizedMatmul::eval(const std::vector<array>& inputs, array& out) {
   auto biases = ensure_row_contiguous(biases_pre);
 
   out.set_data(allocator::malloc_or_wait(out.nbytes()));
-  _qmm_dispatch(out, x, w, scales, biases, group_size_, bits_, transpose_);
+  _qmm_dispatch(out, x, w, scales, biases, bits_, group_size_, transpose_);
 }
 
 void GatherQMM::eval(const std::vector<array>& inputs, array& out) {
@@ -447,8 +506,8 @@ void GatherQMM::eval(const std::vector<array>& inputs, array& out) {
       biases,
       lhs_indices,
       rhs_indices,
-      group_size_,
       bits_,
+      group_size_,
       transpose_);
 }
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "mlx/backend/common/parallel.h"
 #include "mlx/backend/common/utils.h"
 
 namespace mlx::core {
@@ -104,9 +105,30 @@ void reduction_op(
   ReductionPlan plan = get_reduction_plan(x, axes);
 
   if (plan.type == ContiguousAllReduce) {
+    // Reduce fixed size blocks independently and combine the partial results
+    // in order so that the result does not depend on the number of threads.
+    const T* x_ptr = x.data<T>();
+    int64_t size = x.size();
+    int64_t block = cpu::default_grain_size;
+    int64_t n_blocks = (size + block - 1) / block;
     U* out_ptr = out.data<U>();
+    if (n_blocks <= 1) {
+      *out_ptr = init;
+      opc(x_ptr, out_ptr, size);
+      return;
+    }
+    std::vector<U> partials(n_blocks, init);
+    cpu::parallel_for(n_blocks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        U acc = init;
+        opc(x_ptr + i * block, &acc, std::min(block, size - i * block));
+        partials[i] = acc;
+      }
+    });
     *out_ptr = init;
-    opc(x.data<T>(), out_ptr, x.size());
+    for (U p : partials) {
+      op(out_ptr, p);
+    }
     return;
   }
 
@@ -114,10 +136,13 @@ void reduction_op(
     int reduction_size = plan.shape[0];
     const T* x_ptr = x.data<T>();
     U* out_ptr = out.data<U>();
-    for (int i = 0; i < out.size(); i++, out_ptr++, x_ptr += reduction_size) {
-      *out_ptr = init;
-      opc(x_ptr, out_ptr, reduction_size);
-    }
+    int64_t grain = cpu::grain_size(reduction_size);
+    cpu::parallel_for(out.size(), grain, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        out_ptr[i] = init;
+        opc(x_ptr + i * reduction_size, out_ptr + i, reduction_size);
+      }
+    });
     return;
   }
 
@@ -130,24 +155,27 @@ void reduction_op(
     // Unrolling the following loop (and implementing it in order for
     // ContiguousReduce) should hold extra performance boost.
     auto [shape, strides] = shapes_without_reduction_axes(x, axes);
-    if (plan.shape.size() == 0) {
-      for (int i = 0; i < out.size(); i++, out_ptr++) {
-        int offset = elem_to_loc(i, shape, strides);
-        *out_ptr = init;
-        opc(x_ptr + offset, out_ptr, reduction_size);
-      }
-    } else {
-      for (int i = 0; i < out.size(); i++, out_ptr++) {
+    int64_t reduced = reduction_size;
+    for (auto s : plan.shape) {
+      reduced *= s;
+    }
+    int64_t grain = cpu::grain_size(reduced);
+    cpu::parallel_for(out.size(), grain, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
         int offset = elem_to_loc(i, shape, strides);
-        *out_ptr = init;
-        nd_loop(
-            [&](int extra_offset) {
-              opc(x_ptr + offset + extra_offset, out_ptr, reduction_size);
-            },
-            plan.shape,
-            plan.strides);
+        out_ptr[i] = init;
+        if (plan.shape.size() == 0) {
+          opc(x_ptr + offset, out_ptr + i, reduction_size);
+        } else {
+          nd_loop(
+              [&](int extra_offset) {
+                opc(x_ptr + offset + extra_offset, out_ptr + i, reduction_size);
+              },
+              plan.shape,
+              plan.strides);
+        }
       }
-    }
+    });
     return;
   }
 
@@ -158,12 +186,16 @@ void reduction_op(
     plan.strides.pop_back();
     const T* x_ptr = x.data<T>();
     U* out_ptr = out.data<U>();
-    for (int i = 0; i < out.size(); i += reduction_stride) {
-      std::fill_n(out_ptr, reduction_stride, init);
-      ops(x_ptr, out_ptr, reduction_size, reduction_stride);
-      x_ptr += reduction_stride * reduction_size;
-      out_ptr += reduction_stride;
-    }
+    int64_t block = reduction_stride * reduction_size;
+    int64_t grain = cpu::grain_size(block);
+    cpu::parallel_for(
+        out.size() / reduction_stride, grain, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            U* acc = out_ptr + i * reduction_stride;
+            std::fill_n(acc, reduction_stride, init);
+            ops(x_ptr + i * block, acc, reduction_size, reduction_stride);
+          }
+        });
     return;
   }
 
@@ -176,29 +208,32 @@ void reduction_op(
     const T* x_ptr = x.data<T>();
     U* out_ptr = out.data<U>();
     auto [shape, strides] = shapes_without_reduction_axes(x, axes);
-    if (plan.shape.size() == 0) {
-      for (int i = 0; i < out.size(); i += reduction_stride) {
-        int offset = elem_to_loc(i, shape, strides);
-        std::fill_n(out_ptr, reduction_stride, init);
-        ops(x_ptr + offset, out_ptr, reduction_size, reduction_stride);
-        out_ptr += reduction_stride;
-      }
-    } else {
-      for (int i = 0; i < out.size(); i += reduction_stride) {
-        int offset = elem_to_loc(i, shape, strides);
-        std::fill_n(out_ptr, reduction_stride, init);
-        nd_loop(
-            [&](int extra_offset) {
-              ops(x_ptr + offset + extra_offset,
-                  out_ptr,
-                  reduction_size,
-                  reduction_stride);
-            },
-            plan.shape,
-            plan.strides);
-        out_ptr += reduction_stride;
-      }
+    int64_t reduced = reduction_size * reduction_stride;
+    for (auto s : plan.shape) {
+      reduced *= s;
     }
+    int64_t grain = cpu::grain_size(reduced);
+    cpu::parallel_for(
+        out.size() / reduction_stride, grain, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            int offset = elem_to_loc(i * reduction_stride, shape, strides);
+            U* acc = out_ptr + i * reduction_stride;
+            std::fill_n(acc, reduction_stride, init);
+            if (plan.shape.size() == 0) {
+              ops(x_ptr + offset, acc, reduction_size, reduction_stride);
+            } else {
+              nd_loop(
+                  [&](int extra_offset) {
+                    ops(x_ptr + offset + extra_offset,
+                        acc,
+                        reduction_size,
+                        reduction_stride);
+                  },
+                  plan.shape,
+                  plan.strides);
+            }
+          }
+        });
     return;
   }
 
@@ -206,15 +241,24 @@ void reduction_op(
     const T* x_ptr = x.data<T>();
     U* out_ptr = out.data<U>();
     auto [shape, strides] = shapes_without_reduction_axes(x, axes);
-    for (int i = 0; i < out.size(); i++, out_ptr++) {
-      int offset = elem_to_loc(i, shape, strides);
-      U val = init;
-      nd_loop(
-          [&](int extra_offset) { op(&val, *(x_ptr + offset + extra_offset)); },
-          plan.shape,
-          plan.strides);
-      *out_ptr = val;
+    int64_t reduced = 1;
+    for (auto s : plan.shape) {
+      reduced *= s;
     }
+    int64_t grain = cpu::grain_size(reduced);
+    cpu::parallel_for(out.size(), grain, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        int offset = elem_to_loc(i, shape, strides);
+        U val = init;
+        nd_loop(
+            [&](int extra_offset) {
+              op(&val, *(x_ptr + offset + extra_offset));
+            },
+            plan.shape,
+            plan.strides);
+        out_ptr[i] = val;
+      }
+    });
   }
 }
 
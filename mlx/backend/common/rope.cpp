@@ -0,0 +1,174 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
+#include "mlx/fast_primitives.h"
+
+namespace mlx::core::fast {
+
+namespace {
+
+template <typename T>
+void to_float(const T* in, float* out, int n) {
+  if constexpr (std::is_same_v<T, float>) {
+    std::copy(in, in + n, out);
+  } else if (!simd::convert(in, out, n)) {
+    for (int i = 0; i < n; i++) {
+      out[i] = static_cast<float>(in[i]);
+    }
+  }
+}
+
+template <typename T>
+void from_float(const float* in, T* out, int n) {
+  if constexpr (std::is_same_v<T, float>) {
+    std::copy(in, in + n, out);
+  } else if (!simd::convert(in, out, n)) {
+    for (int i = 0; i < n; i++) {
+      out[i] = static_cast<T>(in[i]);
+    }
+  }
+}
+
+// Rotate the rows of a row contiguous [..., L, D] array. The cosines and
+// sines are computed once per position in a [L, dims / 2] table shared by all
+// the rows.
+template <typename T>
+void rope(
+    const array& in,
+    array& out,
+    const std::vector<float>& inv_freqs,
+    int dims,
+    bool traditional,
+    float scale,
+    bool forward,
+    int offset) {
+  const int D = in.shape(-1);
+  const int L = in.shape(-2);
+  const int half_dims = dims / 2;
+  const int64_t n_rows = in.size() / D;
+
+  // The inverse rotation is the forward one with the sines negated
+  std::vector<float> coss(int64_t(L) * half_dims);
+  std::vector<float> sins(coss.size());
+  float sign = forward ? 1.0f : -1.0f;
+  cpu::parallel_for(
+      L, cpu::grain_size(16 * half_dims), [&](int64_t begin, int64_t end) {
+        for (int64_t l = begin; l < end; l++) {
+          float position = scale * static_cast<float>(l + offset);
+          for (int i = 0; i < half_dims; i++) {
+            float theta = position * inv_freqs[i];
+            coss[l * half_dims + i] = std::cos(theta);
+            sins[l * half_dims + i] = sign * std::sin(theta);
+          }
+        }
+      });
+
+  const T* in_ptr = in.data<T>();
+  T* out_ptr = out.data<T>();
+  cpu::parallel_for(
+      n_rows, cpu::grain_size(D), [&](int64_t begin, int64_t end) {
+        std::vector<float> x(D);
+        std::vector<float> x1(half_dims);
+        std::vector<float> x2(half_dims);
+        for (int64_t r = begin; r < end; r++) {
+          const float* c = coss.data() + (r % L) * half_dims;
+          const float* s = sins.data() + (r % L) * half_dims;
+          to_float(in_ptr + r * D, x.data(), D);
+          if (traditional) {
+            for (int i = 0; i < half_dims; i++) {
+              x1[i] = x[2 * i];
+              x2[i] = x[2 * i + 1];
+            }
+          } else {
+            std::copy(x.begin(), x.begin() + half_dims, x1.begin());
+            std::copy(
+                x.begin() + half_dims, x.begin() + 2 * half_dims, x2.begin());
+          }
+          for (int i = 0; i < half_dims; i++) {
+            float a = x1[i];
+            float b = x2[i];
+            x1[i] = a * c[i] - b * s[i];
+            x2[i] = a * s[i] + b * c[i];
+          }
+          if (traditional) {
+            for (int i = 0; i < half_dims; i++) {
+              x[2 * i] = x1[i];
+              x[2 * i + 1] = x2[i];
+            }
+          } else {
+            std::copy(x1.begin(), x1.end(), x.begin());
+            std::copy(x2.begin(), x2.end(), x.begin() + half_dims);
+          }
+          from_float(x.data(), out_ptr + r * D, D);
+        }
+      });
+}
+
+} // namespace
+
+void RoPE::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(outputs.size() == 1);
+  auto& out = outputs[0];
+  auto in = inputs[0];
+  if (in.ndim() < 3) {
+    throw std::runtime_error("[RoPE] Input must have at least 3 dimensions");
+  }
+  if (!in.flags().row_contiguous) {
+    array in_copy(in.shape(), in.dtype(), nullptr, {});
+    copy(in, in_copy, CopyType::General);
+    in = in_copy;
+  }
+  if (in.is_donatable()) {
+    out.copy_shared_buffer(in);
+  } else {
+    out.set_data(allocator::malloc_or_wait(out.nbytes()));
+  }
+  if (in.size() == 0) {
+    return;
+  }
+
+  int half_dims = dims_ / 2;
+  std::vector<float> inv_freqs(half_dims);
+  if (inputs.size() == 3) {
+    auto& freqs = inputs[2];
+    const float* freqs_ptr = freqs.data<float>();
+    auto freq_stride = freqs.strides()[0];
+    for (int i = 0; i < half_dims; i++) {
+      inv_freqs[i] = 1.0f / freqs_ptr[i * freq_stride];
+    }
+  } else {
+    float log_base = std::log2(base_);
+    for (int i = 0; i < half_dims; i++) {
+      float d = static_cast<float>(i) / static_cast<float>(half_dims);
+      inv_freqs[i] = std::exp2(-d * log_base);
+    }
+  }
+  int offset = inputs[1].data<int32_t>()[0];
+
+  switch (in.dtype()) {
+    case float32:
+      rope<float>(
+          in, out, inv_freqs, dims_, traditional_, scale_, forward_, offset);
+      break;
+    case float16:
+      rope<float16_t>(
+          in, out, inv_freqs, dims_, traditional_, scale_, forward_, offset);
+      break;
+    case bfloat16:
+      rope<bfloat16_t>(
+          in, out, inv_freqs, dims_, traditional_, scale_, forward_, offset);
+      break;
+    default:
+      throw std::runtime_error("[RoPE::eval_cpu] Unsupported type.");
+  }
+}
+
+} // namespace mlx::core::fast
@@ -0,0 +1,367 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "mlx/allocator.h"
+#include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/ops.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
+#include "mlx/backend/common/threading.h"
+#include "mlx/fast_primitives.h"
+
+namespace mlx::core::fast {
+
+namespace {
+
+// Query rows attended together by one task, counted over all the query heads
+// that share a key/value head, and keys processed per step of the online
+// softmax.
+constexpr int block_rows = 64;
+constexpr int block_k = 64;
+
+constexpr float neg_inf = -std::numeric_limits<float>::infinity();
+
+// A [B, H, L, D] array with a contiguous last dimension
+template <typename T>
+struct Heads {
+  const T* data;
+  int64_t stride_b;
+  int64_t stride_h;
+  int64_t stride_l;
+
+  Heads(const array& a)
+      : data(a.data<T>()),
+        stride_b(a.strides()[0]),
+        stride_h(a.strides()[1]),
+        stride_l(a.strides()[2]) {}
+
+  const T* row(int b, int h, int l) const {
+    return data + b * stride_b + h * stride_h + l * stride_l;
+  }
+};
+
+template <typename T>
+struct Params {
+  Heads<T> q;
+  Heads<T> k;
+  Heads<T> v;
+  const T* mask; // Broadcasted to [B, n_q_heads, L, S] or null
+  Strides mask_strides;
+  float scale;
+  int n_repeats;
+  int head_dim;
+  int value_dim;
+};
+
+// The running state of the online softmax for a set of query rows. The
+// output rows are not normalized.
+struct State {
+  std::vector<float> q;
+  std::vector<float> max;
+  std::vector<float> sum;
+  std::vector<float> out;
+  std::vector<float> scores;
+  std::vector<float> keys;
+  std::vector<float> values;
+
+  State(int rows, int head_dim, int value_dim)
+      : q(rows * head_dim),
+        max(rows),
+        sum(rows),
+        out(rows * value_dim),
+        scores(rows * block_k),
+        keys(block_k * head_dim),
+        values(block_k * value_dim) {}
+};
+
+template <typename T>
+void to_float(const T* in, float* out, int n) {
+  if constexpr (std::is_same_v<T, float>) {
+    std::copy(in, in + n, out);
+  } else if (!simd::convert(in, out, n)) {
+    for (int i = 0; i < n; i++) {
+      out[i] = static_cast<float>(in[i]);
+    }
+  }
+}
+
+inline void exp_inplace(float* x, int n) {
+  if (!simd::unary(detail::Exp(), x, x, n)) {
+    for (int i = 0; i < n; i++) {
+      x[i] = detail::Exp()(x[i]);
+    }
+  }
+}
+
+inline float dot(const float* a, const float* b, int n) {
+  constexpr int lanes = 8;
+  float partial[lanes] = {};
+  int i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    for (int l = 0; l < lanes; l++) {
+      partial[l] += a[i + l] * b[i + l];
+    }
+  }
+  float sum = 0;
+  for (; i < n; i++) {
+    sum += a[i] * b[i];
+  }
+  for (int l = 0; l < lanes; l++) {
+    sum += partial[l];
+  }
+  return sum;
+}
+
+// Attend the queries [q0, q0 + n_q) of all the query heads of the key/value
+// head h to the keys [k_begin, k_end). The rows of the state are ordered by
+// query head and then by query.
+template <typename T>
+void attend(
+    const Params<T>& p,
+    State& st,
+    int b,
+    int h,
+    int q0,
+    int n_q,
+    int k_begin,
+    int k_end) {
+  const int D = p.head_dim;
+  const int Dv = p.value_dim;
+  const int rows = p.n_repeats * n_q;
+
+  for (int r = 0; r < rows; r++) {
+    float* q = st.q.data() + r * D;
+    to_float(p.q.row(b, h * p.n_repeats + r / n_q, q0 + r % n_q), q, D);
+    for (int d = 0; d < D; d++) {
+      q[d] *= p.scale;
+    }
+  }
+  std::fill(st.max.begin(), st.max.begin() + rows, neg_inf);
+  std::fill(st.sum.begin(), st.sum.begin() + rows, 0.0f);
+  std::fill(st.out.begin(), st.out.begin() + rows * Dv, 0.0f);
+
+  for (int k0 = k_begin; k0 < k_end; k0 += block_k) {
+    int n_k = std::min(block_k, k_end - k0);
+    for (int c = 0; c < n_k; c++) {
+      to_float(p.k.row(b, h, k0 + c), st.keys.data() + c * D, D);
+      to_float(p.v.row(b, h, k0 + c), st.values.data() + c * Dv, Dv);
+    }
+
+    for (int r = 0; r < rows; r++) {
+      const float* q = st.q.data() + r * D;
+      float* s = st.scores.data() + r * block_k;
+      for (int c = 0; c < n_k; c++) {
+        s[c] = dot(q, st.keys.data() + c * D, D);
+      }
+      if (p.mask != nullptr) {
+        const T* mask = p.mask + b * p.mask_strides[0] +
+            (h * p.n_repeats + r / n_q) * p.mask_strides[1] +
+            (q0 + r % n_q) * p.mask_strides[2] + k0 * p.mask_strides[3];
+        for (int c = 0; c < n_k; c++) {
+          s[c] += static_cast<float>(mask[c * p.mask_strides[3]]);
+        }
+      }
+
+      // Rescale the state to the new maximum and accumulate the block
+      float block_max = *std::max_element(s, s + n_k);
+      float new_max = std::max(st.max[r], block_max);
+      if (new_max == neg_inf) {
+        continue;
+      }
+      for (int c = 0; c < n_k; c++) {
+        s[c] -= new_max;
+      }
+      exp_inplace(s, n_k);
+      float factor = std::exp(st.max[r] - new_max);
+      float* o = st.out.data() + r * Dv;
+      float block_sum = 0;
+      for (int c = 0; c < n_k; c++) {
+        block_sum += s[c];
+      }
+      st.sum[r] = st.sum[r] * factor + block_sum;
+      st.max[r] = new_max;
+      for (int d = 0; d < Dv; d++) {
+        o[d] *= factor;
+      }
+      for (int c = 0; c < n_k; c++) {
+        const float* v = st.values.data() + c * Dv;
+        float sc = s[c];
+        for (int d = 0; d < Dv; d++) {
+          o[d] += sc * v[d];
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void sdpa(const Params<T>& p, array& out, int B, int H_kv, int L, int S) {
+  const int Dv = p.value_dim;
+  const int n_q_heads = H_kv * p.n_repeats;
+  T* out_ptr = out.data<T>();
+  auto out_row = [&](int b, int h, int l) {
+    return out_ptr + ((int64_t(b) * n_q_heads + h) * L + l) * Dv;
+  };
+
+  if (L == 1) {
+    // Decoding. Split the keys of every head in chunks so that all the
+    // threads are busy and merge the partial softmaxes at the end.
+    int n_heads = B * H_kv;
+    int max_chunks = std::max(1, (S + block_k - 1) / block_k);
+    int n_chunks = std::clamp(
+        (2 * cpu::get_num_threads() + n_heads - 1) / n_heads, 1, max_chunks);
+    int chunk = ((S + n_chunks - 1) / n_chunks + block_k - 1) / block_k *
+        block_k;
+    n_chunks = std::max(1, (S + chunk - 1) / chunk);
+
+    int rows = p.n_repeats;
+    std::vector<float> maxs(int64_t(n_heads) * n_chunks * rows, neg_inf);
+    std::vector<float> sums(maxs.size(), 0.0f);
+    std::vector<float> outs(maxs.size() * Dv, 0.0f);
+    cpu::parallel_for(
+        int64_t(n_heads) * n_chunks, 1, [&](int64_t begin, int64_t end) {
+          State st(rows, p.head_dim, Dv);
+          for (int64_t t = begin; t < end; t++) {
+            int bh = t / n_chunks;
+            int k_begin = (t % n_chunks) * chunk;
+            int k_end = std::min(S, k_begin + chunk);
+            attend(p, st, bh / H_kv, bh % H_kv, 0, 1, k_begin, k_end);
+            std::copy(
+                st.max.begin(), st.max.begin() + rows, &maxs[t * rows]);
+            std::copy(
+                st.sum.begin(), st.sum.begin() + rows, &sums[t * rows]);
+            std::copy(
+                st.out.begin(),
+                st.out.begin() + rows * Dv,
+                &outs[t * rows * Dv]);
+          }
+        });
+
+    std::vector<float> o(Dv);
+    for (int bh = 0; bh < n_heads; bh++) {
+      for (int r = 0; r < rows; r++) {
+        auto idx = [&](int c) {
+          return (int64_t(bh) * n_chunks + c) * rows + r;
+        };
+        float m = neg_inf;
+        for (int c = 0; c < n_chunks; c++) {
+          m = std::max(m, maxs[idx(c)]);
+        }
+        float sum = 0;
+        std::fill(o.begin(), o.end(), 0.0f);
+        for (int c = 0; c < n_chunks; c++) {
+          if (maxs[idx(c)] == neg_inf) {
+            continue;
+          }
+          float factor = std::exp(maxs[idx(c)] - m);
+          sum += sums[idx(c)] * factor;
+          const float* oc = &outs[idx(c) * Dv];
+          for (int d = 0; d < Dv; d++) {
+            o[d] += oc[d] * factor;
+          }
+        }
+        T* dst = out_row(bh / H_kv, (bh % H_kv) * p.n_repeats + r, 0);
+        for (int d = 0; d < Dv; d++) {
+          dst[d] = static_cast<T>(o[d] / sum);
+        }
+      }
+    }
+    return;
+  }
+
+  // Every task attends a block of queries of all the query heads sharing a
+  // key/value head to all the keys so each key block is converted once for
+  // all of them.
+  int n_q = std::max(1, block_rows / p.n_repeats);
+  int q_blocks = (L + n_q - 1) / n_q;
+  int64_t task_work = int64_t(n_q) * p.n_repeats * S * (p.head_dim + Dv);
+  cpu::parallel_for(
+      int64_t(B) * H_kv * q_blocks,
+      cpu::grain_size(task_work),
+      [&](int64_t begin, int64_t end) {
+        State st(n_q * p.n_repeats, p.head_dim, Dv);
+        for (int64_t t = begin; t < end; t++) {
+          int bh = t / q_blocks;
+          int b = bh / H_kv;
+          int h = bh % H_kv;
+          int q0 = (t % q_blocks) * n_q;
+          int nq = std::min(n_q, L - q0);
+          attend(p, st, b, h, q0, nq, 0, S);
+          for (int r = 0; r < nq * p.n_repeats; r++) {
+            const float* o = st.out.data() + r * Dv;
+            T* dst = out_row(b, h * p.n_repeats + r / nq, q0 + r % nq);
+            for (int d = 0; d < Dv; d++) {
+              dst[d] = static_cast<T>(o[d] / st.sum[r]);
+            }
+          }
+        }
+      });
+}
+
+} // namespace
+
+void ScaledDotProductAttention::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 3 || inputs.size() == 4);
+  auto& out = outputs[0];
+  out.set_data(allocator::malloc_or_wait(out.nbytes()));
+
+  std::vector<array> copies;
+  auto last_contiguous = [&copies](const array& x) {
+    if (x.strides()[x.ndim() - 1] == 1) {
+      return x;
+    }
+    array x_copy(x.shape(), x.dtype(), nullptr, {});
+    copy(x, x_copy, CopyType::General);
+    copies.push_back(x_copy);
+    return x_copy;
+  };
+  auto q = last_contiguous(inputs[0]);
+  auto k = last_contiguous(inputs[1]);
+  auto v = last_contiguous(inputs[2]);
+
+  int B = q.shape(0);
+  int L = q.shape(2);
+  int H_kv = k.shape(1);
+  int S = k.shape(2);
+  if (S == 0) {
+    std::fill_n(out.data<char>(), out.nbytes(), 0);
+    return;
+  }
+
+  auto run = [&](auto type_tag) {
+    using T = decltype(type_tag);
+    Params<T> p{
+        Heads<T>(q),
+        Heads<T>(k),
+        Heads<T>(v),
+        inputs.size() > 3 ? inputs[3].data<T>() : nullptr,
+        inputs.size() > 3 ? inputs[3].strides() : Strides{},
+        scale_,
+        q.shape(1) / H_kv,
+        q.shape(-1),
+        v.shape(-1)};
+    sdpa<T>(p, out, B, H_kv, L, S);
+  };
+  switch (out.dtype()) {
+    case float32:
+      run(float{});
+      break;
+    case float16:
+      run(float16_t{});
+      break;
+    case bfloat16:
+      run(bfloat16_t{});
+      break;
+    default:
+      throw std::runtime_error(
+          "[ScaledDotProductAttention::eval_cpu] Unsupported type.");
+  }
+}
+
+} // namespace mlx::core::fast
@@ -1,8 +1,11 @@
 // Copyright © 2023 Apple Inc.
 
 #include <cassert>
+#include <memory>
 
 #include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
 #include "mlx/backend/common/utils.h"
 #include "mlx/primitives.h"
 
@@ -80,6 +83,45 @@ struct DefaultContiguousScan {
   }
 };
 
+// Forward float32 sums are scanned in registers, everything else uses the
+// default scan
+template <typename T, typename U, typename Op>
+struct ContiguousSumScan : DefaultContiguousScan<T, U, Op> {
+  using DefaultContiguousScan<T, U, Op>::DefaultContiguousScan;
+
+  void operator()(
+      const T* input,
+      U* output,
+      int count,
+      int stride,
+      bool reverse,
+      bool inclusive) {
+    if constexpr (std::is_same_v<T, U>) {
+      if (!reverse) {
+        U carry = this->init;
+        if (!inclusive) {
+          *output = carry;
+        }
+        int offset = inclusive ? 0 : 1;
+        if (simd::cumsum(input, output + offset, stride - offset, carry)) {
+          for (int i = 1; i < count; i++) {
+            input += stride;
+            output += stride;
+            carry = this->init;
+            if (!inclusive) {
+              *output = carry;
+            }
+            simd::cumsum(input, output + offset, stride - offset, carry);
+          }
+          return;
+        }
+      }
+    }
+    DefaultContiguousScan<T, U, Op>::operator()(
+        input, output, count, stride, reverse, inclusive);
+  }
+};
+
 template <typename T, typename U, typename Op>
 struct DefaultStridedScan {
   Op op;
@@ -160,6 +202,63 @@ struct DefaultStridedScan {
   }
 };
 
+// Scan a single long row with all the threads. The row is split in blocks
+// which are scanned independently, then each block is offset by the combined
+// total of the blocks before it in the direction of the scan.
+template <typename T, typename U, typename OpCS>
+void scan_long_row(
+    OpCS& opcs,
+    const T* input,
+    U* output,
+    int size,
+    bool reverse,
+    bool inclusive) {
+  auto& op = opcs.op;
+  int64_t n_blocks = std::min<int64_t>(
+      cpu::get_num_threads(), size / cpu::default_grain_size);
+  int64_t block = (size + n_blocks - 1) / n_blocks;
+  n_blocks = (size + block - 1) / block;
+
+  // Not a std::vector since U can be bool
+  auto totals = std::make_unique<U[]>(n_blocks);
+  cpu::parallel_for(n_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      int64_t start = b * block;
+      int n = std::min<int64_t>(block, size - start);
+      opcs(input + start, output + start, 1, n, reverse, inclusive);
+      int64_t last = reverse ? start : start + n - 1;
+      if (inclusive) {
+        totals[b] = output[last];
+      } else {
+        op(&totals[b], output + last, input + last);
+      }
+    }
+  });
+
+  // Replace each total with the combined total of the blocks before it
+  U carry = opcs.init;
+  for (int64_t i = 0; i < n_blocks; i++) {
+    int64_t b = reverse ? n_blocks - 1 - i : i;
+    U total = totals[b];
+    totals[b] = carry;
+    op(&carry, &carry, &total);
+  }
+
+  int64_t first = reverse ? n_blocks - 1 : 0;
+  cpu::parallel_for(n_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      if (b == first) {
+        continue;
+      }
+      U* out = output + b * block;
+      int n = std::min<int64_t>(block, size - b * block);
+      for (int i = 0; i < n; i++) {
+        op(out + i, &totals[b], out + i);
+      }
+    }
+  });
+}
+
 template <typename T, typename U, typename OpCS, typename OpSS>
 void scan_op(
     OpCS opcs,
@@ -172,23 +271,51 @@ void scan_op(
   output.set_data(allocator::malloc_or_wait(output.nbytes()));
 
   if (input.flags().row_contiguous) {
+    const T* in_ptr = input.data<T>();
+    U* out_ptr = output.data<U>();
     if (input.strides()[axis] == 1) {
-      opcs(
-          input.data<T>(),
-          output.data<U>(),
-          input.size() / input.shape(axis),
-          input.shape(axis),
-          reverse,
-          inclusive);
+      int size = std::max(input.shape(axis), 1);
+      int64_t n_rows = input.size() / size;
+      if (n_rows < cpu::get_num_threads() &&
+          size >= 2 * cpu::default_grain_size) {
+        // Too few rows to keep the threads busy so split the rows instead
+        for (int64_t i = 0; i < n_rows; i++) {
+          scan_long_row(
+              opcs,
+              in_ptr + i * size,
+              out_ptr + i * size,
+              size,
+              reverse,
+              inclusive);
+        }
+        return;
+      }
+      int64_t grain = cpu::grain_size(size);
+      cpu::parallel_for(n_rows, grain, [&](int64_t begin, int64_t end) {
+        opcs(
+            in_ptr + begin * size,
+            out_ptr + begin * size,
+            end - begin,
+            size,
+            reverse,
+            inclusive);
+      });
     } else {
-      opss(
-          input.data<T>(),
-          output.data<U>(),
-          input.size() / input.shape(axis) / input.strides()[axis],
-          input.shape(axis),
-          input.strides()[axis],
-          reverse,
-          inclusive);
+      int size = input.shape(axis);
+      int stride = input.strides()[axis];
+      int64_t block = std::max<int64_t>(int64_t(size) * stride, 1);
+      int64_t grain = cpu::grain_size(block);
+      cpu::parallel_for(
+          input.size() / block, grain, [&](int64_t begin, int64_t end) {
+            opss(
+                in_ptr + begin * block,
+                out_ptr + begin * block,
+                end - begin,
+                size,
+                stride,
+                reverse,
+                inclusive);
+          });
     }
   } else {
     throw std::runtime_error("Scan op supports only contiguous inputs");
@@ -205,15 +332,15 @@ void scan_dispatch(
     bool inclusive) {
   switch (rtype) {
     case Scan::Sum: {
-      auto op = [](U* o, const U* y, const T* x) { *o = *y + *x; };
+      auto op = [](U* o, const U* y, const auto* x) { *o = *y + *x; };
       auto init = static_cast<U>(0);
-      auto opcs = DefaultContiguousScan<T, U, decltype(op)>(op, init);
+      auto opcs = ContiguousSumScan<T, U, decltype(op)>(op, init);
       auto opss = DefaultStridedScan<T, U, decltype(op)>(op, init);
       scan_op<T, U>(opcs, opss, input, output, axis, reverse, inclusive);
       break;
     }
     case Scan::Prod: {
-      auto op = [](U* o, const U* y, const T* x) { *o = *y * (*x); };
+      auto op = [](U* o, const U* y, const auto* x) { *o = *y * (*x); };
       auto init = static_cast<U>(1);
       auto opcs = DefaultContiguousScan<T, U, decltype(op)>(op, init);
       auto opss = DefaultStridedScan<T, U, decltype(op)>(op, init);
@@ -221,7 +348,9 @@ void scan_dispatch(
       break;
     }
     case Scan::Min: {
-      auto op = [](U* o, const U* y, const T* x) { *o = (*x < *y) ? *x : *y; };
+      auto op = [](U* o, const U* y, const auto* x) {
+        *o = (*x < *y) ? *x : *y;
+      };
       auto init = (issubdtype(input.dtype(), floating))
           ? static_cast<U>(std::numeric_limits<float>::infinity())
           : std::numeric_limits<U>::max();
@@ -231,7 +360,9 @@ void scan_dispatch(
       break;
     }
     case Scan::Max: {
-      auto op = [](U* o, const U* y, const T* x) { *o = (*x < *y) ? *y : *x; };
+      auto op = [](U* o, const U* y, const auto* x) {
+        *o = (*x < *y) ? *y : *x;
+      };
       auto init = (issubdtype(input.dtype(), floating))
           ? static_cast<U>(-std::numeric_limits<float>::infinity())
           : std::numeric_limits<U>::min();
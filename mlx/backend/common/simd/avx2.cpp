@@ -0,0 +1,180 @@
+// Copyright © 2024 Apple Inc.
+
+// Compiled with -mavx2 -mfma -mf16c. Only selected at runtime on CPUs that
+// support AVX2 and FMA (see simd.cpp).
+
+#include <immintrin.h>
+
+#include "mlx/backend/common/simd/math.h"
+
+namespace mlx::core::simd {
+
+namespace {
+
+struct Avx2 {
+  using reg = __m256;
+  using mask = __m256;
+  static constexpr size_t width = 8;
+
+  static reg load(const float* p) {
+    return _mm256_loadu_ps(p);
+  }
+  static void store(float* p, reg x) {
+    _mm256_storeu_ps(p, x);
+  }
+  static reg set1(float x) {
+    return _mm256_set1_ps(x);
+  }
+  static reg set1_bits(uint32_t x) {
+    return _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(x)));
+  }
+  static reg zero() {
+    return _mm256_setzero_ps();
+  }
+
+  static reg add(reg a, reg b) {
+    return _mm256_add_ps(a, b);
+  }
+  static reg sub(reg a, reg b) {
+    return _mm256_sub_ps(a, b);
+  }
+  static reg mul(reg a, reg b) {
+    return _mm256_mul_ps(a, b);
+  }
+  static reg div(reg a, reg b) {
+    return _mm256_div_ps(a, b);
+  }
+  static reg fma(reg a, reg b, reg c) {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+  static reg min(reg a, reg b) {
+    return _mm256_min_ps(a, b);
+  }
+  static reg max(reg a, reg b) {
+    return _mm256_max_ps(a, b);
+  }
+  static reg sqrt(reg x) {
+    return _mm256_sqrt_ps(x);
+  }
+  static reg floor(reg x) {
+    return _mm256_floor_ps(x);
+  }
+  static reg abs(reg x) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+  }
+  static reg neg(reg x) {
+    return _mm256_xor_ps(x, _mm256_set1_ps(-0.0f));
+  }
+  static reg copysign(reg mag, reg sign) {
+    reg sign_mask = _mm256_set1_ps(-0.0f);
+    return _mm256_or_ps(
+        _mm256_andnot_ps(sign_mask, mag), _mm256_and_ps(sign_mask, sign));
+  }
+
+  static mask eq(reg a, reg b) {
+    return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+  }
+  static mask lt(reg a, reg b) {
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+  }
+  static mask gt(reg a, reg b) {
+    return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+  }
+  static mask ge(reg a, reg b) {
+    return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+  }
+  static mask isnan(reg x) {
+    return _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+  }
+  static mask mask_or(mask a, mask b) {
+    return _mm256_or_ps(a, b);
+  }
+  static reg select(mask m, reg a, reg b) {
+    return _mm256_blendv_ps(b, a, m);
+  }
+
+  static reg prefix_sum(reg x) {
+    // Scan each 128-bit half and then add the total of the low half to the
+    // high half
+    x = _mm256_add_ps(
+        x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+    x = _mm256_add_ps(
+        x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+    __m256 t = _mm256_permute_ps(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_add_ps(x, _mm256_permute2f128_ps(t, t, 0x08));
+  }
+  static reg broadcast_last(reg x) {
+    __m256 t = _mm256_permute_ps(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_permute2f128_ps(t, t, 0x11);
+  }
+
+  static reg pow2i(reg n) {
+    __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+  }
+  static reg frexp(reg x, reg& e) {
+    __m256i bits = _mm256_castps_si256(x);
+    e = _mm256_cvtepi32_ps(_mm256_sub_epi32(
+        _mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    bits = _mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff));
+    bits = _mm256_or_si256(bits, _mm256_set1_epi32(0x3f000000));
+    return _mm256_castsi256_ps(bits);
+  }
+};
+
+void float16_to_float32(const uint16_t* in, float* out, size_t n) {
+  convert_loop<8>(in, out, n, [](const uint16_t* x, float* y) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x));
+    _mm256_storeu_ps(y, _mm256_cvtph_ps(h));
+  });
+}
+
+void float32_to_float16(const float* in, uint16_t* out, size_t n) {
+  convert_loop<8>(in, out, n, [](const float* x, uint16_t* y) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(x), _MM_FROUND_TO_NEAREST_INT);
+    // Match the NaN encoding of the scalar conversion
+    __m128i nan = _mm_cmpgt_epi16(
+        _mm_and_si128(h, _mm_set1_epi16(0x7fff)), _mm_set1_epi16(0x7c00));
+    __m128i qnan = _mm_or_si128(
+        _mm_and_si128(h, _mm_set1_epi16(-0x8000)), _mm_set1_epi16(0x7d00));
+    h = _mm_blendv_epi8(h, qnan, nan);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(y), h);
+  });
+}
+
+void bfloat16_to_float32(const uint16_t* in, float* out, size_t n) {
+  convert_loop<8>(in, out, n, [](const uint16_t* x, float* y) {
+    __m256i u = _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(x)));
+    _mm256_storeu_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(u, 16)));
+  });
+}
+
+void float32_to_bfloat16(const float* in, uint16_t* out, size_t n) {
+  convert_loop<8>(in, out, n, [](const float* x, uint16_t* y) {
+    __m256 v = _mm256_loadu_ps(x);
+    __m256i u = _mm256_castps_si256(v);
+    // Round to nearest even
+    __m256i lsb =
+        _mm256_and_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(1));
+    u = _mm256_add_epi32(u, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff)));
+    u = _mm256_srli_epi32(u, 16);
+    __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+    u = _mm256_blendv_epi8(u, _mm256_set1_epi32(0x7fc0), nan);
+    __m128i h = _mm_packus_epi32(
+        _mm256_castsi256_si128(u), _mm256_extracti128_si256(u, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(y), h);
+  });
+}
+
+} // namespace
+
+void avx2_kernels(KernelTable& table) {
+  fill_kernel_table<Avx2>(table);
+  table.float16_to_float32 = float16_to_float32;
+  table.float32_to_float16 = float32_to_float16;
+  table.bfloat16_to_float32 = bfloat16_to_float32;
+  table.float32_to_bfloat16 = float32_to_bfloat16;
+}
+
+} // namespace mlx::core::simd
@@ -0,0 +1,185 @@
+// Copyright © 2024 Apple Inc.
+
+// Compiled with -mavx512f -mavx2 -mfma -mf16c. Only selected at runtime on
+// CPUs that support AVX-512F (see simd.cpp).
+
+#include <immintrin.h>
+
+#include "mlx/backend/common/simd/math.h"
+
+namespace mlx::core::simd {
+
+namespace {
+
+struct Avx512 {
+  using reg = __m512;
+  using mask = __mmask16;
+  static constexpr size_t width = 16;
+
+  static reg load(const float* p) {
+    return _mm512_loadu_ps(p);
+  }
+  static void store(float* p, reg x) {
+    _mm512_storeu_ps(p, x);
+  }
+  static reg set1(float x) {
+    return _mm512_set1_ps(x);
+  }
+  static reg set1_bits(uint32_t x) {
+    return _mm512_castsi512_ps(_mm512_set1_epi32(static_cast<int>(x)));
+  }
+  static reg zero() {
+    return _mm512_setzero_ps();
+  }
+
+  static reg add(reg a, reg b) {
+    return _mm512_add_ps(a, b);
+  }
+  static reg sub(reg a, reg b) {
+    return _mm512_sub_ps(a, b);
+  }
+  static reg mul(reg a, reg b) {
+    return _mm512_mul_ps(a, b);
+  }
+  static reg div(reg a, reg b) {
+    return _mm512_div_ps(a, b);
+  }
+  static reg fma(reg a, reg b, reg c) {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+  static reg min(reg a, reg b) {
+    return _mm512_min_ps(a, b);
+  }
+  static reg max(reg a, reg b) {
+    return _mm512_max_ps(a, b);
+  }
+  static reg sqrt(reg x) {
+    return _mm512_sqrt_ps(x);
+  }
+  static reg floor(reg x) {
+    return _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+  }
+  static reg abs(reg x) {
+    return _mm512_castsi512_ps(_mm512_and_si512(
+        _mm512_castps_si512(x), _mm512_set1_epi32(0x7fffffff)));
+  }
+  static reg neg(reg x) {
+    return _mm512_castsi512_ps(_mm512_xor_si512(
+        _mm512_castps_si512(x), _mm512_set1_epi32(-0x7fffffff - 1)));
+  }
+  static reg copysign(reg mag, reg sign) {
+    __m512i abs_mask = _mm512_set1_epi32(0x7fffffff);
+    return _mm512_castsi512_ps(_mm512_or_si512(
+        _mm512_and_si512(abs_mask, _mm512_castps_si512(mag)),
+        _mm512_andnot_si512(abs_mask, _mm512_castps_si512(sign))));
+  }
+
+  static mask eq(reg a, reg b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+  }
+  static mask lt(reg a, reg b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+  }
+  static mask gt(reg a, reg b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+  }
+  static mask ge(reg a, reg b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+  }
+  static mask isnan(reg x) {
+    return _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+  }
+  static mask mask_or(mask a, mask b) {
+    return _mm512_kor(a, b);
+  }
+  static reg select(mask m, reg a, reg b) {
+    return _mm512_mask_blend_ps(m, b, a);
+  }
+
+  // Moves the lanes up by k and fills the bottom ones with zeros
+  template <int k>
+  static reg shift_up(reg x) {
+    return _mm512_castsi512_ps(_mm512_alignr_epi32(
+        _mm512_castps_si512(x), _mm512_setzero_si512(), 16 - k));
+  }
+  static reg prefix_sum(reg x) {
+    x = _mm512_add_ps(x, shift_up<1>(x));
+    x = _mm512_add_ps(x, shift_up<2>(x));
+    x = _mm512_add_ps(x, shift_up<4>(x));
+    return _mm512_add_ps(x, shift_up<8>(x));
+  }
+  static reg broadcast_last(reg x) {
+    return _mm512_permutexvar_ps(_mm512_set1_epi32(15), x);
+  }
+
+  static reg pow2i(reg n) {
+    __m512i e = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(e, 23));
+  }
+  static reg frexp(reg x, reg& e) {
+    __m512i bits = _mm512_castps_si512(x);
+    e = _mm512_cvtepi32_ps(_mm512_sub_epi32(
+        _mm512_srli_epi32(bits, 23), _mm512_set1_epi32(126)));
+    bits = _mm512_and_si512(bits, _mm512_set1_epi32(0x007fffff));
+    bits = _mm512_or_si512(bits, _mm512_set1_epi32(0x3f000000));
+    return _mm512_castsi512_ps(bits);
+  }
+};
+
+void float16_to_float32(const uint16_t* in, float* out, size_t n) {
+  convert_loop<16>(in, out, n, [](const uint16_t* x, float* y) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+    _mm512_storeu_ps(y, _mm512_cvtph_ps(h));
+  });
+}
+
+void float32_to_float16(const float* in, uint16_t* out, size_t n) {
+  convert_loop<16>(in, out, n, [](const float* x, uint16_t* y) {
+    __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(x), _MM_FROUND_TO_NEAREST_INT);
+    // Match the NaN encoding of the scalar conversion
+    __m256i nan = _mm256_cmpgt_epi16(
+        _mm256_and_si256(h, _mm256_set1_epi16(0x7fff)),
+        _mm256_set1_epi16(0x7c00));
+    __m256i qnan = _mm256_or_si256(
+        _mm256_and_si256(h, _mm256_set1_epi16(-0x8000)),
+        _mm256_set1_epi16(0x7d00));
+    h = _mm256_blendv_epi8(h, qnan, nan);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(y), h);
+  });
+}
+
+void bfloat16_to_float32(const uint16_t* in, float* out, size_t n) {
+  convert_loop<16>(in, out, n, [](const uint16_t* x, float* y) {
+    __m512i u = _mm512_cvtepu16_epi32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x)));
+    _mm512_storeu_ps(y, _mm512_castsi512_ps(_mm512_slli_epi32(u, 16)));
+  });
+}
+
+void float32_to_bfloat16(const float* in, uint16_t* out, size_t n) {
+  convert_loop<16>(in, out, n, [](const float* x, uint16_t* y) {
+    __m512 v = _mm512_loadu_ps(x);
+    __m512i u = _mm512_castps_si512(v);
+    // Round to nearest even
+    __m512i lsb =
+        _mm512_and_si512(_mm512_srli_epi32(u, 16), _mm512_set1_epi32(1));
+    u = _mm512_add_epi32(u, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7fff)));
+    u = _mm512_srli_epi32(u, 16);
+    u = _mm512_mask_blend_epi32(
+        _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q), u, _mm512_set1_epi32(0x7fc0));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(y), _mm512_cvtepi32_epi16(u));
+  });
+}
+
+} // namespace
+
+void avx512_kernels(KernelTable& table) {
+  fill_kernel_table<Avx512>(table);
+  table.float16_to_float32 = float16_to_float32;
+  table.float32_to_float16 = float32_to_float16;
+  table.bfloat16_to_float32 = bfloat16_to_float32;
+  table.float32_to_bfloat16 = float32_to_bfloat16;
+}
+
+} // namespace mlx::core::simd
@@ -0,0 +1,72 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+// This header is included by the translation units that are compiled for a
+// specific instruction set so it must not pull in any inline code (e.g. from
+// the standard library) that could end up shared with the rest of the library.
+#include <cstddef>
+#include <cstdint>
+
+namespace mlx::core::simd {
+
+enum class UnaryKernel {
+  Abs,
+  Erf,
+  Exp,
+  Log,
+  Negative,
+  Sigmoid,
+  Sqrt,
+  Square,
+  Count,
+};
+
+enum class BinaryKernel {
+  Add,
+  Divide,
+  Maximum,
+  Minimum,
+  Multiply,
+  Subtract,
+  Count,
+};
+
+// Which of the inputs of a binary kernel is a single broadcasted value
+enum class BinaryMode {
+  VectorVector,
+  ScalarVector,
+  VectorScalar,
+};
+
+using UnaryFn = void (*)(const float* in, float* out, size_t n);
+using BinaryFn = void (*)(
+    const float* a,
+    const float* b,
+    float* out,
+    size_t n,
+    BinaryMode mode);
+// Writes the inclusive prefix sums of in offset by carry and returns the last
+// one (carry if n is 0)
+using ScanFn = float (*)(const float* in, float* out, size_t n, float carry);
+using ToFloatFn = void (*)(const uint16_t* in, float* out, size_t n);
+using FromFloatFn = void (*)(const float* in, uint16_t* out, size_t n);
+
+// Kernels over contiguous float32 buffers for one instruction set. The
+// kernels support in-place computation (out == in). A null entry means the
+// operation is not vectorized and the scalar fallback should be used.
+struct KernelTable {
+  UnaryFn unary[static_cast<int>(UnaryKernel::Count)]{};
+  BinaryFn binary[static_cast<int>(BinaryKernel::Count)]{};
+  ScanFn cumsum{nullptr};
+  ToFloatFn float16_to_float32{nullptr};
+  FromFloatFn float32_to_float16{nullptr};
+  ToFloatFn bfloat16_to_float32{nullptr};
+  FromFloatFn float32_to_bfloat16{nullptr};
+};
+
+void avx2_kernels(KernelTable& table);
+void avx512_kernels(KernelTable& table);
+void neon_kernels(KernelTable& table);
+
+} // namespace mlx::core::simd
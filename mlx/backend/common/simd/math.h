@@ -0,0 +1,356 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include "mlx/backend/common/simd/kernels.h"
+
+// Vectorized math written against a small per instruction set interface V
+// which provides:
+//
+//   reg, mask, width
+//   load, store, set1, set1_bits, zero
+//   add, sub, mul, div, fma (a * b + c), min, max, sqrt, floor, abs, neg,
+//   copysign
+//   eq, lt, gt, ge, isnan, mask_or, select (mask ? a : b)
+//   pow2i (2^n for integral n), frexp (mantissa in [0.5, 1) and exponent)
+//   prefix_sum (inclusive prefix sum of the lanes), broadcast_last
+//
+// Everything here is instantiated with a V that lives in an anonymous
+// namespace so the generated code stays local to the instruction set specific
+// translation unit.
+
+namespace mlx::core::simd {
+
+namespace vec {
+
+constexpr uint32_t inf_bits = 0x7f800000;
+constexpr uint32_t neg_inf_bits = 0xff800000;
+constexpr uint32_t nan_bits = 0x7fc00000;
+constexpr uint32_t min_normal_bits = 0x00800000;
+
+struct Abs {
+  template <typename V>
+  static typename V::reg apply(typename V::reg x) {
+    return V::abs(x);
+  }
+};
+
+struct Negative {
+  template <typename V>
+  static typename V::reg apply(typename V::reg x) {
+    return V::neg(x);
+  }
+};
+
+struct Sqrt {
+  template <typename V>
+  static typename V::reg apply(typename V::reg x) {
+    return V::sqrt(x);
+  }
+};
+
+struct Square {
+  template <typename V>
+  static typename V::reg apply(typename V::reg x) {
+    return V::mul(x, x);
+  }
+};
+
+// Same approximation as detail::fast_exp including the clamping of the
+// exponent to [-80, 80].
+struct Exp {
+  template <typename V>
+  static typename V::reg apply(typename V::reg x) {
+    using R = typename V::reg;
+    R y = V::mul(x, V::set1(1.442695f));
+    y = V::max(V::min(y, V::set1(80.0f)), V::set1(-80.0f));
+
+    // Round to the nearest integer with ties going up
+    R ipart = V::floor(y);
+    ipart = V::select(
+        V::ge(V::sub(y, ipart), V::set1(0.5f)),
+        V::add(ipart, V::set1(1.0f)),
+        ipart);
+    R fpart = V::sub(y, ipart);
+
+    R p = V::set1(1.535336188319500e-4f);
+    p = V::fma(p, fpart, V::set1(1.339887440266574e-3f));
+    p = V::fma(p, fpart, V::set1(9.618437357674640e-3f));
+    p = V::fma(p, fpart, V::set1(5.550332471162809e-2f));
+    p = V::fma(p, fpart, V::set1(2.402264791363012e-1f));
+    p = V::fma(p, fpart, V::set1(6.931472028550421e-1f));
+    p = V::fma(p, fpart, V::set1(1.0f));
+    R r = V::mul(V::pow2i(ipart), p);
+
+    r = V::select(V::eq(x, V::set1_bits(neg_inf_bits)), V::zero(), r);
+    return V::select(
+        V::mask_or(V::eq(x, V::set1_bits(inf_bits)), V::isnan(x)), x, r);
+  }
+};
+
+// The natural logarithm following the Cephes logf approximation.
+struct Log {
+  template <typename V>
+  static typename V::reg apply(typename V::reg x) {
+    using R = typename V::reg;
+    R one = V::set1(1.0f);
+
+    // Scale denormals into the normal range
+    auto denormal = V::lt(x, V::set1_bits(min_normal_bits));
+    R e;
+    R m = V::frexp(V::select(denormal, V::mul(x, V::set1(8388608.0f)), x), e);
+    e = V::select(denormal, V::sub(e, V::set1(23.0f)), e);
+
+    // Move the mantissa to [sqrt(1/2), sqrt(2)) and subtract one
+    auto small = V::lt(m, V::set1(0.707106781186547524f));
+    e = V::select(small, V::sub(e, one), e);
+    m = V::sub(V::select(small, V::add(m, m), m), one);
+
+    R z = V::mul(m, m);
+    R y = V::set1(7.0376836292e-2f);
+    y = V::fma(y, m, V::set1(-1.1514610310e-1f));
+    y = V::fma(y, m, V::set1(1.1676998740e-1f));
+    y = V::fma(y, m, V::set1(-1.2420140846e-1f));
+    y = V::fma(y, m, V::set1(1.4249322787e-1f));
+    y = V::fma(y, m, V::set1(-1.6668057665e-1f));
+    y = V::fma(y, m, V::set1(2.0000714765e-1f));
+    y = V::fma(y, m, V::set1(-2.4999993993e-1f));
+    y = V::fma(y, m, V::set1(3.3333331174e-1f));
+    y = V::mul(V::mul(y, m), z);
+    y = V::fma(e, V::set1(-2.12194440e-4f), y);
+    y = V::fma(z, V::set1(-0.5f), y);
+    R r = V::fma(e, V::set1(0.693359375f), V::add(m, y));
+
+    r = V::select(V::eq(x, V::set1_bits(inf_bits)), x, r);
+    r = V::select(V::eq(x, V::zero()), V::set1_bits(neg_inf_bits), r);
+    r = V::select(V::lt(x, V::zero()), V::set1_bits(nan_bits), r);
+    return V::select(V::isnan(x), x, r);
+  }
+};
+
+struct Sigmoid {
+  template <typename V>
+  static typename V::reg apply(typename V::reg x) {
+    auto one = V::set1(1.0f);
+    return V::div(one, V::add(one, Exp::apply<V>(V::neg(x))));
+  }
+};
+
+// Same approximation as detail::fast_erf with both branches evaluated.
+struct Erf {
+  template <typename V>
+  static typename V::reg apply(typename V::reg a) {
+    using R = typename V::reg;
+    R t = V::abs(a);
+    R s = V::mul(a, a);
+
+    R r = V::fma(V::set1(-1.72853470e-5f), t, V::set1(3.83197126e-4f));
+    R u = V::fma(V::set1(-3.88396438e-3f), t, V::set1(2.42546219e-2f));
+    r = V::fma(r, s, u);
+    r = V::fma(r, t, V::set1(-1.06777877e-1f));
+    r = V::fma(r, t, V::set1(-6.34846687e-1f));
+    r = V::fma(r, t, V::set1(-1.28717512e-1f));
+    r = V::fma(r, t, V::neg(t));
+    r = V::copysign(V::sub(V::set1(1.0f), Exp::apply<V>(r)), a);
+
+    R q = V::set1(-5.96761703e-4f);
+    q = V::fma(q, s, V::set1(4.99119423e-3f));
+    q = V::fma(q, s, V::set1(-2.67681349e-2f));
+    q = V::fma(q, s, V::set1(1.12819925e-1f));
+    q = V::fma(q, s, V::set1(-3.76125336e-1f));
+    q = V::fma(q, s, V::set1(1.28379166e-1f));
+    q = V::fma(q, a, a);
+
+    return V::select(V::gt(t, V::set1(0.927734375f)), r, q);
+  }
+};
+
+struct Add {
+  template <typename V>
+  static typename V::reg apply(typename V::reg a, typename V::reg b) {
+    return V::add(a, b);
+  }
+};
+
+struct Divide {
+  template <typename V>
+  static typename V::reg apply(typename V::reg a, typename V::reg b) {
+    return V::div(a, b);
+  }
+};
+
+// NaNs propagate from either side like detail::Maximum and detail::Minimum
+struct Maximum {
+  template <typename V>
+  static typename V::reg apply(typename V::reg a, typename V::reg b) {
+    return V::select(V::isnan(a), a, V::select(V::gt(a, b), a, b));
+  }
+};
+
+struct Minimum {
+  template <typename V>
+  static typename V::reg apply(typename V::reg a, typename V::reg b) {
+    return V::select(V::isnan(a), a, V::select(V::lt(a, b), a, b));
+  }
+};
+
+struct Multiply {
+  template <typename V>
+  static typename V::reg apply(typename V::reg a, typename V::reg b) {
+    return V::mul(a, b);
+  }
+};
+
+struct Subtract {
+  template <typename V>
+  static typename V::reg apply(typename V::reg a, typename V::reg b) {
+    return V::sub(a, b);
+  }
+};
+
+} // namespace vec
+
+// Apply f to full vectors of in and to the remainder through a padded
+// buffer so that every element goes through the same code path.
+template <typename V, typename F>
+inline void unary_loop(const float* in, float* out, size_t n, F f) {
+  constexpr size_t w = V::width;
+  size_t i = 0;
+  for (; i + w <= n; i += w) {
+    V::store(out + i, f(V::load(in + i)));
+  }
+  if (i < n) {
+    float buf[w];
+    for (size_t j = 0; j < w; j++) {
+      buf[j] = (i + j < n) ? in[i + j] : 0.0f;
+    }
+    V::store(buf, f(V::load(buf)));
+    for (size_t j = 0; i + j < n; j++) {
+      out[i + j] = buf[j];
+    }
+  }
+}
+
+template <typename V, typename Op>
+void unary_kernel(const float* in, float* out, size_t n) {
+  unary_loop<V>(
+      in, out, n, [](typename V::reg x) { return Op::template apply<V>(x); });
+}
+
+template <typename V, typename Op>
+void binary_kernel(
+    const float* a,
+    const float* b,
+    float* out,
+    size_t n,
+    BinaryMode mode) {
+  using R = typename V::reg;
+  switch (mode) {
+    case BinaryMode::ScalarVector: {
+      R va = V::set1(*a);
+      unary_loop<V>(b, out, n, [va](R x) {
+        return Op::template apply<V>(va, x);
+      });
+      return;
+    }
+    case BinaryMode::VectorScalar: {
+      R vb = V::set1(*b);
+      unary_loop<V>(a, out, n, [vb](R x) {
+        return Op::template apply<V>(x, vb);
+      });
+      return;
+    }
+    case BinaryMode::VectorVector:
+      break;
+  }
+
+  constexpr size_t w = V::width;
+  size_t i = 0;
+  for (; i + w <= n; i += w) {
+    V::store(out + i, Op::template apply<V>(V::load(a + i), V::load(b + i)));
+  }
+  if (i < n) {
+    float buf_a[w];
+    float buf_b[w];
+    for (size_t j = 0; j < w; j++) {
+      buf_a[j] = (i + j < n) ? a[i + j] : 0.0f;
+      buf_b[j] = (i + j < n) ? b[i + j] : 0.0f;
+    }
+    V::store(buf_a, Op::template apply<V>(V::load(buf_a), V::load(buf_b)));
+    for (size_t j = 0; i + j < n; j++) {
+      out[i + j] = buf_a[j];
+    }
+  }
+}
+
+// Convert W elements at a time with f(in, out) and the remainder through
+// padded buffers.
+template <size_t W, typename InT, typename OutT, typename F>
+inline void convert_loop(const InT* in, OutT* out, size_t n, F f) {
+  size_t i = 0;
+  for (; i + W <= n; i += W) {
+    f(in + i, out + i);
+  }
+  if (i < n) {
+    InT buf_in[W];
+    OutT buf_out[W];
+    for (size_t j = 0; j < W; j++) {
+      buf_in[j] = (i + j < n) ? in[i + j] : InT(0);
+    }
+    f(buf_in, buf_out);
+    for (size_t j = 0; i + j < n; j++) {
+      out[i + j] = buf_out[j];
+    }
+  }
+}
+
+// The prefix sum of each register is computed in place with lane shifts and
+// offset by the running total so the additions happen in a different order
+// than a sequential loop.
+template <typename V>
+float cumsum_kernel(const float* in, float* out, size_t n, float carry) {
+  auto c = V::set1(carry);
+  size_t i = 0;
+  for (; i + V::width <= n; i += V::width) {
+    auto x = V::add(V::prefix_sum(V::load(in + i)), c);
+    V::store(out + i, x);
+    c = V::broadcast_last(x);
+  }
+  if (i > 0) {
+    carry = out[i - 1];
+  }
+  for (; i < n; i++) {
+    carry += in[i];
+    out[i] = carry;
+  }
+  return carry;
+}
+
+template <typename V>
+void fill_kernel_table(KernelTable& table) {
+  auto set_unary = [&table](UnaryKernel k, UnaryFn fn) {
+    table.unary[static_cast<int>(k)] = fn;
+  };
+  set_unary(UnaryKernel::Abs, unary_kernel<V, vec::Abs>);
+  set_unary(UnaryKernel::Erf, unary_kernel<V, vec::Erf>);
+  set_unary(UnaryKernel::Exp, unary_kernel<V, vec::Exp>);
+  set_unary(UnaryKernel::Log, unary_kernel<V, vec::Log>);
+  set_unary(UnaryKernel::Negative, unary_kernel<V, vec::Negative>);
+  set_unary(UnaryKernel::Sigmoid, unary_kernel<V, vec::Sigmoid>);
+  set_unary(UnaryKernel::Sqrt, unary_kernel<V, vec::Sqrt>);
+  set_unary(UnaryKernel::Square, unary_kernel<V, vec::Square>);
+
+  auto set_binary = [&table](BinaryKernel k, BinaryFn fn) {
+    table.binary[static_cast<int>(k)] = fn;
+  };
+  set_binary(BinaryKernel::Add, binary_kernel<V, vec::Add>);
+  set_binary(BinaryKernel::Divide, binary_kernel<V, vec::Divide>);
+  set_binary(BinaryKernel::Maximum, binary_kernel<V, vec::Maximum>);
+  set_binary(BinaryKernel::Minimum, binary_kernel<V, vec::Minimum>);
+  set_binary(BinaryKernel::Multiply, binary_kernel<V, vec::Multiply>);
+  set_binary(BinaryKernel::Subtract, binary_kernel<V, vec::Subtract>);
+
+  table.cumsum = cumsum_kernel<V>;
+}
+
+} // namespace mlx::core::simd
@@ -0,0 +1,164 @@
+// Copyright © 2024 Apple Inc.
+
+// NEON is part of the baseline of 64-bit ARM so these kernels are always
+// selected there (see simd.cpp).
+
+#include <arm_neon.h>
+
+#include "mlx/backend/common/simd/math.h"
+
+namespace mlx::core::simd {
+
+namespace {
+
+struct Neon {
+  using reg = float32x4_t;
+  using mask = uint32x4_t;
+  static constexpr size_t width = 4;
+
+  static reg load(const float* p) {
+    return vld1q_f32(p);
+  }
+  static void store(float* p, reg x) {
+    vst1q_f32(p, x);
+  }
+  static reg set1(float x) {
+    return vdupq_n_f32(x);
+  }
+  static reg set1_bits(uint32_t x) {
+    return vreinterpretq_f32_u32(vdupq_n_u32(x));
+  }
+  static reg zero() {
+    return vdupq_n_f32(0.0f);
+  }
+
+  static reg add(reg a, reg b) {
+    return vaddq_f32(a, b);
+  }
+  static reg sub(reg a, reg b) {
+    return vsubq_f32(a, b);
+  }
+  static reg mul(reg a, reg b) {
+    return vmulq_f32(a, b);
+  }
+  static reg div(reg a, reg b) {
+    return vdivq_f32(a, b);
+  }
+  static reg fma(reg a, reg b, reg c) {
+    return vfmaq_f32(c, a, b);
+  }
+  static reg min(reg a, reg b) {
+    return vminq_f32(a, b);
+  }
+  static reg max(reg a, reg b) {
+    return vmaxq_f32(a, b);
+  }
+  static reg sqrt(reg x) {
+    return vsqrtq_f32(x);
+  }
+  static reg floor(reg x) {
+    return vrndmq_f32(x);
+  }
+  static reg abs(reg x) {
+    return vabsq_f32(x);
+  }
+  static reg neg(reg x) {
+    return vnegq_f32(x);
+  }
+  static reg copysign(reg mag, reg sign) {
+    return vbslq_f32(vdupq_n_u32(0x80000000), sign, mag);
+  }
+
+  static mask eq(reg a, reg b) {
+    return vceqq_f32(a, b);
+  }
+  static mask lt(reg a, reg b) {
+    return vcltq_f32(a, b);
+  }
+  static mask gt(reg a, reg b) {
+    return vcgtq_f32(a, b);
+  }
+  static mask ge(reg a, reg b) {
+    return vcgeq_f32(a, b);
+  }
+  static mask isnan(reg x) {
+    return vmvnq_u32(vceqq_f32(x, x));
+  }
+  static mask mask_or(mask a, mask b) {
+    return vorrq_u32(a, b);
+  }
+  static reg select(mask m, reg a, reg b) {
+    return vbslq_f32(m, a, b);
+  }
+
+  static reg prefix_sum(reg x) {
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    x = vaddq_f32(x, vextq_f32(zero, x, 3));
+    return vaddq_f32(x, vextq_f32(zero, x, 2));
+  }
+  static reg broadcast_last(reg x) {
+    return vdupq_laneq_f32(x, 3);
+  }
+
+  static reg pow2i(reg n) {
+    int32x4_t e = vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127));
+    return vreinterpretq_f32_s32(vshlq_n_s32(e, 23));
+  }
+  static reg frexp(reg x, reg& e) {
+    uint32x4_t bits = vreinterpretq_u32_f32(x);
+    e = vcvtq_f32_s32(vsubq_s32(
+        vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126)));
+    bits = vandq_u32(bits, vdupq_n_u32(0x007fffff));
+    bits = vorrq_u32(bits, vdupq_n_u32(0x3f000000));
+    return vreinterpretq_f32_u32(bits);
+  }
+};
+
+void float16_to_float32(const uint16_t* in, float* out, size_t n) {
+  convert_loop<4>(in, out, n, [](const uint16_t* x, float* y) {
+    vst1q_f32(y, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(x))));
+  });
+}
+
+void float32_to_float16(const float* in, uint16_t* out, size_t n) {
+  convert_loop<4>(in, out, n, [](const float* x, uint16_t* y) {
+    uint16x4_t h = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(x)));
+    // Match the NaN encoding of the scalar conversion
+    uint16x4_t nan =
+        vcgt_u16(vand_u16(h, vdup_n_u16(0x7fff)), vdup_n_u16(0x7c00));
+    uint16x4_t qnan =
+        vorr_u16(vand_u16(h, vdup_n_u16(0x8000)), vdup_n_u16(0x7d00));
+    vst1_u16(y, vbsl_u16(nan, qnan, h));
+  });
+}
+
+void bfloat16_to_float32(const uint16_t* in, float* out, size_t n) {
+  convert_loop<4>(in, out, n, [](const uint16_t* x, float* y) {
+    vst1q_f32(y, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(x), 16)));
+  });
+}
+
+void float32_to_bfloat16(const float* in, uint16_t* out, size_t n) {
+  convert_loop<4>(in, out, n, [](const float* x, uint16_t* y) {
+    float32x4_t v = vld1q_f32(x);
+    uint32x4_t u = vreinterpretq_u32_f32(v);
+    // Round to nearest even
+    uint32x4_t lsb = vandq_u32(vshrq_n_u32(u, 16), vdupq_n_u32(1));
+    u = vaddq_u32(u, vaddq_u32(lsb, vdupq_n_u32(0x7fff)));
+    u = vshrq_n_u32(u, 16);
+    u = vbslq_u32(vmvnq_u32(vceqq_f32(v, v)), vdupq_n_u32(0x7fc0), u);
+    vst1_u16(y, vmovn_u32(u));
+  });
+}
+
+} // namespace
+
+void neon_kernels(KernelTable& table) {
+  fill_kernel_table<Neon>(table);
+  table.float16_to_float32 = float16_to_float32;
+  table.float32_to_float16 = float32_to_float16;
+  table.bfloat16_to_float32 = bfloat16_to_float32;
+  table.float32_to_bfloat16 = float32_to_bfloat16;
+}
+
+} // namespace mlx::core::simd
@@ -0,0 +1,37 @@
+// Copyright © 2024 Apple Inc.
+
+#include "mlx/backend/common/simd/simd.h"
+
+namespace mlx::core::simd {
+
+namespace {
+
+KernelTable select_kernels() {
+  KernelTable table;
+#ifdef MLX_SIMD_AVX512
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") &&
+      __builtin_cpu_supports("fma")) {
+    avx512_kernels(table);
+    return table;
+  }
+#endif
+#ifdef MLX_SIMD_AVX2
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    avx2_kernels(table);
+    return table;
+  }
+#endif
+#ifdef MLX_SIMD_NEON
+  neon_kernels(table);
+#endif
+  return table;
+}
+
+} // namespace
+
+const KernelTable& kernels() {
+  static const KernelTable table = select_kernels();
+  return table;
+}
+
+} // namespace mlx::core::simd
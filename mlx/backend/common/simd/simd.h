@@ -0,0 +1,226 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+
+#include "mlx/array.h"
+#include "mlx/backend/common/ops.h"
+#include "mlx/backend/common/simd/kernels.h"
+
+namespace mlx::core::simd {
+
+// The kernels for the best instruction set supported by the CPU, selected
+// once at runtime.
+const KernelTable& kernels();
+
+namespace {
+
+// Half precision inputs are processed in blocks of this many elements that
+// are converted to float32 on the stack.
+constexpr size_t block_size = 1024;
+
+template <typename T>
+constexpr bool is_vectorizable_v = std::is_same_v<T, float> ||
+    std::is_same_v<T, float16_t> || std::is_same_v<T, bfloat16_t>;
+
+template <typename Op>
+constexpr UnaryKernel unary_kernel() {
+  if constexpr (std::is_same_v<Op, detail::Abs>) {
+    return UnaryKernel::Abs;
+  } else if constexpr (std::is_same_v<Op, detail::Erf>) {
+    return UnaryKernel::Erf;
+  } else if constexpr (std::is_same_v<Op, detail::Exp>) {
+    return UnaryKernel::Exp;
+  } else if constexpr (std::is_same_v<Op, detail::Log>) {
+    return UnaryKernel::Log;
+  } else if constexpr (std::is_same_v<Op, detail::Negative>) {
+    return UnaryKernel::Negative;
+  } else if constexpr (std::is_same_v<Op, detail::Sigmoid>) {
+    return UnaryKernel::Sigmoid;
+  } else if constexpr (std::is_same_v<Op, detail::Sqrt>) {
+    return UnaryKernel::Sqrt;
+  } else if constexpr (std::is_same_v<Op, detail::Square>) {
+    return UnaryKernel::Square;
+  } else {
+    return UnaryKernel::Count;
+  }
+}
+
+template <typename Op>
+constexpr BinaryKernel binary_kernel() {
+  if constexpr (std::is_same_v<Op, detail::Add>) {
+    return BinaryKernel::Add;
+  } else if constexpr (std::is_same_v<Op, detail::Divide>) {
+    return BinaryKernel::Divide;
+  } else if constexpr (std::is_same_v<Op, detail::Maximum>) {
+    return BinaryKernel::Maximum;
+  } else if constexpr (std::is_same_v<Op, detail::Minimum>) {
+    return BinaryKernel::Minimum;
+  } else if constexpr (std::is_same_v<Op, detail::Multiply>) {
+    return BinaryKernel::Multiply;
+  } else if constexpr (std::is_same_v<Op, detail::Subtract>) {
+    return BinaryKernel::Subtract;
+  } else {
+    return BinaryKernel::Count;
+  }
+}
+
+template <typename T>
+const uint16_t* as_bits(const T* x) {
+  return reinterpret_cast<const uint16_t*>(x);
+}
+
+template <typename T>
+uint16_t* as_bits(T* x) {
+  return reinterpret_cast<uint16_t*>(x);
+}
+
+template <typename T>
+ToFloatFn to_float32() {
+  if constexpr (std::is_same_v<T, float16_t>) {
+    return kernels().float16_to_float32;
+  } else {
+    return kernels().bfloat16_to_float32;
+  }
+}
+
+template <typename T>
+FromFloatFn from_float32() {
+  if constexpr (std::is_same_v<T, float16_t>) {
+    return kernels().float32_to_float16;
+  } else {
+    return kernels().float32_to_bfloat16;
+  }
+}
+
+} // namespace
+
+// Convert n contiguous elements between float32 and float16 or bfloat16.
+// Returns false if the pair of types or the CPU is not supported in which
+// case nothing is written.
+template <typename SrcT, typename DstT>
+bool convert(const SrcT* src, DstT* dst, size_t n) {
+  if constexpr (
+      std::is_same_v<DstT, float> &&
+      (std::is_same_v<SrcT, float16_t> || std::is_same_v<SrcT, bfloat16_t>)) {
+    auto fn = to_float32<SrcT>();
+    if (fn == nullptr) {
+      return false;
+    }
+    fn(as_bits(src), dst, n);
+    return true;
+  } else if constexpr (
+      std::is_same_v<SrcT, float> &&
+      (std::is_same_v<DstT, float16_t> || std::is_same_v<DstT, bfloat16_t>)) {
+    auto fn = from_float32<DstT>();
+    if (fn == nullptr) {
+      return false;
+    }
+    fn(src, as_bits(dst), n);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+// Compute out[i] = op(in[i]) for n contiguous elements with the vectorized
+// kernel for op. Returns false if op, the types or the CPU are not supported
+// in which case nothing is written.
+template <typename Op, typename T, typename U>
+bool unary(Op, const T* in, U* out, size_t n) {
+  constexpr auto k = unary_kernel<Op>();
+  if constexpr (
+      !std::is_same_v<T, U> || !is_vectorizable_v<T> ||
+      k == UnaryKernel::Count) {
+    return false;
+  } else {
+    auto fn = kernels().unary[static_cast<int>(k)];
+    if (fn == nullptr) {
+      return false;
+    }
+    if constexpr (std::is_same_v<T, float>) {
+      fn(in, out, n);
+    } else {
+      auto to_float = to_float32<T>();
+      auto from_float = from_float32<T>();
+      float buf[block_size];
+      for (size_t i = 0; i < n; i += block_size) {
+        size_t m = std::min(block_size, n - i);
+        to_float(as_bits(in + i), buf, m);
+        fn(buf, buf, m);
+        from_float(buf, as_bits(out + i), m);
+      }
+    }
+    return true;
+  }
+}
+
+// Compute out[i] = op(a[i], b[i]) for n contiguous elements with the
+// vectorized kernel for op. The mode says if a or b is a single scalar.
+// Returns false if op, the types or the CPU are not supported in which case
+// nothing is written.
+template <typename Op, typename T, typename U>
+bool binary(Op, const T* a, const T* b, U* out, size_t n, BinaryMode mode) {
+  constexpr auto k = binary_kernel<Op>();
+  if constexpr (
+      !std::is_same_v<T, U> || !is_vectorizable_v<T> ||
+      k == BinaryKernel::Count) {
+    return false;
+  } else {
+    auto fn = kernels().binary[static_cast<int>(k)];
+    if (fn == nullptr) {
+      return false;
+    }
+    if constexpr (std::is_same_v<T, float>) {
+      fn(a, b, out, n, mode);
+    } else {
+      auto to_float = to_float32<T>();
+      auto from_float = from_float32<T>();
+      float scalar;
+      float buf_a[block_size];
+      float buf_b[block_size];
+      const float* fa = buf_a;
+      const float* fb = buf_b;
+      if (mode == BinaryMode::ScalarVector) {
+        scalar = static_cast<float>(*a);
+        fa = &scalar;
+      } else if (mode == BinaryMode::VectorScalar) {
+        scalar = static_cast<float>(*b);
+        fb = &scalar;
+      }
+      for (size_t i = 0; i < n; i += block_size) {
+        size_t m = std::min(block_size, n - i);
+        if (mode != BinaryMode::ScalarVector) {
+          to_float(as_bits(a + i), buf_a, m);
+        }
+        if (mode != BinaryMode::VectorScalar) {
+          to_float(as_bits(b + i), buf_b, m);
+        }
+        fn(fa, fb, buf_a, m, mode);
+        from_float(buf_a, as_bits(out + i), m);
+      }
+    }
+    return true;
+  }
+}
+
+// Compute the inclusive prefix sums of n contiguous elements offset by carry
+// and update carry to the last one. Returns false if the type or the CPU are
+// not supported in which case nothing is written.
+template <typename T>
+bool cumsum(const T* in, T* out, size_t n, T& carry) {
+  if constexpr (!std::is_same_v<T, float>) {
+    return false;
+  } else {
+    auto fn = kernels().cumsum;
+    if (fn == nullptr) {
+      return false;
+    }
+    carry = fn(in, out, n, carry);
+    return true;
+  }
+}
+
+} // namespace mlx::core::simd
@@ -4,6 +4,7 @@
 #include <cmath>
 
 #include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/parallel.h"
 #include "mlx/primitives.h"
 
 namespace mlx::core {
@@ -11,11 +12,7 @@ namespace mlx::core {
 namespace {
 
 template <typename T, typename AccT>
-void softmax(const array& in, array& out) {
-  const T* in_ptr = in.data<T>();
-  T* out_ptr = out.data<T>();
-  int N = in.shape().back();
-  int M = in.data_size() / N;
+void softmax(const T* in_ptr, T* out_ptr, int M, int N) {
   const T* current_in_ptr;
   T* current_out_ptr;
 
@@ -56,6 +53,19 @@ void softmax(const array& in, array& out) {
   }
 }
 
+template <typename T, typename AccT>
+void softmax(const array& in, array& out) {
+  const T* in_ptr = in.data<T>();
+  T* out_ptr = out.data<T>();
+  int N = in.shape().back();
+  int M = in.data_size() / N;
+  int64_t grain = cpu::grain_size(N);
+  cpu::parallel_for(M, grain, [&](int64_t begin, int64_t end) {
+    softmax<T, AccT>(
+        in_ptr + begin * N, out_ptr + begin * N, end - begin, N);
+  });
+}
+
 } // namespace
 
 void Softmax::eval(const std::vector<array>& inputs, array& out) {
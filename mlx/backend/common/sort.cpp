@@ -3,9 +3,13 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <iterator>
 #include <numeric>
+#include <type_traits>
 
 #include "mlx/backend/common/copy.h"
+#include "mlx/backend/common/parallel.h"
 #include "mlx/backend/common/utils.h"
 
 #include "mlx/primitives.h"
@@ -90,11 +94,11 @@ struct StridedIterator {
     return *this;
   }
 
-  StridedIterator operator+(difference_type diff) {
+  StridedIterator operator+(difference_type diff) const {
     return StridedIterator(ptr_, stride_, diff);
   }
 
-  StridedIterator operator-(difference_type diff) {
+  StridedIterator operator-(difference_type diff) const {
     return StridedIterator(ptr_, stride_, -diff);
   }
 
@@ -103,6 +107,165 @@ struct StridedIterator {
   T* ptr_;
 };
 
+// Rows at least this long are sorted with a radix sort when the type allows
+constexpr int64_t radix_sort_min_size = 1 << 14;
+
+// A partition selecting at most 1 / partial_sort_ratio of a row from either
+// end uses a heap based partial sort instead of nth_element
+constexpr int64_t partial_sort_ratio = 32;
+
+template <typename T>
+constexpr bool is_floating_v = std::is_same_v<T, float> ||
+    std::is_same_v<T, float16_t> || std::is_same_v<T, bfloat16_t>;
+
+template <typename T>
+constexpr bool is_radix_sortable_v =
+    is_floating_v<T> || (std::is_integral_v<T> && !std::is_same_v<T, bool>);
+
+template <typename T>
+inline bool is_nan(T v) {
+  if constexpr (is_floating_v<T>) {
+    return std::isnan(static_cast<float>(v));
+  } else {
+    return false;
+  }
+}
+
+// Order NaNs after all other values like NumPy does, a plain < is not a
+// strict weak ordering in their presence
+template <typename T>
+struct Less {
+  bool operator()(T a, T b) const {
+    if constexpr (is_floating_v<T>) {
+      return a < b || (is_nan(b) && !is_nan(a));
+    } else {
+      return a < b;
+    }
+  }
+};
+
+// Map a value to an unsigned integer which sorts in the same order as Less
+template <typename T>
+inline auto radix_key(T v) {
+  using U = std::conditional_t<
+      sizeof(T) == 1,
+      uint8_t,
+      std::conditional_t<
+          sizeof(T) == 2,
+          uint16_t,
+          std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+  constexpr U sign = U(1) << (8 * sizeof(U) - 1);
+  if constexpr (is_floating_v<T>) {
+    // All NaNs compare equal and last, -0 and 0 compare equal
+    if (is_nan(v)) {
+      return static_cast<U>(~U(0));
+    }
+    if (static_cast<float>(v) == 0) {
+      return sign;
+    }
+    U bits;
+    std::memcpy(&bits, &v, sizeof(U));
+    return static_cast<U>((bits & sign) ? ~bits : (bits | sign));
+  } else if constexpr (std::is_signed_v<T>) {
+    return static_cast<U>(static_cast<U>(v) ^ sign);
+  } else {
+    return static_cast<U>(v);
+  }
+}
+
+// Stable LSD radix sort of a strided row, one byte per pass. Returns the
+// sorting permutation. The row is split in blocks which are counted and
+// scattered in parallel, each block writes its elements in order so the sort
+// stays stable.
+template <typename T, typename IdxT>
+std::vector<IdxT> radix_argsort(const T* data, int64_t stride, int64_t n) {
+  using U = decltype(radix_key(T{}));
+  constexpr int n_buckets = 256;
+
+  int64_t n_blocks = std::min<int64_t>(
+      cpu::get_num_threads(),
+      (n + cpu::default_grain_size - 1) / cpu::default_grain_size);
+  int64_t block = (n + n_blocks - 1) / n_blocks;
+  auto for_each_block = [&](auto fn) {
+    cpu::parallel_for(n_blocks, 1, [&](int64_t b_begin, int64_t b_end) {
+      for (int64_t b = b_begin; b < b_end; b++) {
+        fn(b, b * block, std::min(n, (b + 1) * block));
+      }
+    });
+  };
+
+  std::vector<U> keys(n);
+  std::vector<U> keys_tmp(n);
+  std::vector<IdxT> idx(n);
+  std::vector<IdxT> idx_tmp(n);
+  for_each_block([&](int64_t, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      keys[i] = radix_key(data[i * stride]);
+      idx[i] = i;
+    }
+  });
+
+  std::vector<int64_t> offsets(n_blocks * n_buckets);
+  for (int shift = 0; shift < 8 * sizeof(U); shift += 8) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    for_each_block([&](int64_t b, int64_t begin, int64_t end) {
+      auto counts = offsets.data() + b * n_buckets;
+      for (int64_t i = begin; i < end; i++) {
+        counts[(keys[i] >> shift) & 0xff]++;
+      }
+    });
+
+    // Turn the counts into the position of each block in each bucket. The
+    // pass is skipped if all keys share the digit.
+    int64_t total = 0;
+    bool skip = false;
+    for (int d = 0; d < n_buckets && !skip; d++) {
+      int64_t bucket_start = total;
+      for (int64_t b = 0; b < n_blocks; b++) {
+        auto count = offsets[b * n_buckets + d];
+        offsets[b * n_buckets + d] = total;
+        total += count;
+      }
+      skip = (total - bucket_start) == n;
+    }
+    if (skip) {
+      continue;
+    }
+
+    for_each_block([&](int64_t b, int64_t begin, int64_t end) {
+      auto block_offsets = offsets.data() + b * n_buckets;
+      for (int64_t i = begin; i < end; i++) {
+        auto& o = block_offsets[(keys[i] >> shift) & 0xff];
+        keys_tmp[o] = keys[i];
+        idx_tmp[o] = idx[i];
+        o++;
+      }
+    });
+    std::swap(keys, keys_tmp);
+    std::swap(idx, idx_tmp);
+  }
+  return idx;
+}
+
+// Move the kth element of [st, st + n) to its sorted position with the
+// smaller elements before it and the larger ones after it
+template <typename Iter, typename Compare>
+void partition_row(Iter st, int kth, int n, Compare comp) {
+  if (int64_t(kth + 1) * partial_sort_ratio <= n) {
+    std::partial_sort(st, st + (kth + 1), st + n, comp);
+  } else if (int64_t(n - kth) * partial_sort_ratio <= n) {
+    // Select the largest elements from the back, typically for a top-k
+    auto rst = std::make_reverse_iterator(st + n);
+    std::partial_sort(
+        rst,
+        rst + (n - kth),
+        std::make_reverse_iterator(st),
+        [&comp](const auto& a, const auto& b) { return comp(b, a); });
+  } else {
+    std::nth_element(st, st + kth, st + n, comp);
+  }
+}
+
 template <typename T, typename IdxT = uint32_t>
 void sort(const array& in, array& out, int axis) {
   // Copy input to output
@@ -123,18 +286,37 @@ void sort(const array& in, array& out, int axis) {
   auto axis_stride = out.strides()[axis];
   auto axis_size = out.shape(axis);
 
-  // Perform sorting in place
-  ContiguousIterator src_it(
-      remaining_shape, remaining_strides, remaining_shape.size());
-  for (int i = 0; i < n_rows; i++) {
-    T* data_ptr = out.data<T>() + src_it.loc;
-
-    StridedIterator st(data_ptr, axis_stride, 0);
-    StridedIterator ed(data_ptr, axis_stride, axis_size);
-
-    std::stable_sort(st, ed);
-    src_it.step();
-  }
+  // Perform sorting in place, the rows are split across threads
+  auto out_ptr = out.data<T>();
+  auto sort_rows = [&](int64_t begin, int64_t end) {
+    ContiguousIterator src_it(
+        remaining_shape, remaining_strides, remaining_shape.size());
+    src_it.seek(begin);
+    for (int64_t i = begin; i < end; i++) {
+      T* data_ptr = out_ptr + src_it.loc;
+      src_it.step();
+
+      if constexpr (is_radix_sortable_v<T>) {
+        if (axis_size >= radix_sort_min_size) {
+          auto idx = radix_argsort<T, IdxT>(data_ptr, axis_stride, axis_size);
+          std::vector<T> vals(axis_size);
+          for (int j = 0; j < axis_size; j++) {
+            vals[j] = data_ptr[j * axis_stride];
+          }
+          for (int j = 0; j < axis_size; j++) {
+            data_ptr[j * axis_stride] = vals[idx[j]];
+          }
+          continue;
+        }
+      }
+
+      StridedIterator st(data_ptr, axis_stride, 0);
+      StridedIterator ed(data_ptr, axis_stride, axis_size);
+
+      std::stable_sort(st, ed, Less<T>{});
+    }
+  };
+  cpu::parallel_for(n_rows, cpu::grain_size(axis_size), sort_rows);
 }
 
 template <typename T, typename IdxT = uint32_t>
@@ -162,33 +344,52 @@ void argsort(const array& in, array& out, int axis) {
   auto out_stride = out.strides()[axis];
   auto axis_size = in.shape(axis);
 
-  // Perform sorting
-  ContiguousIterator in_it(
-      in_remaining_shape, in_remaining_strides, in_remaining_shape.size());
-  ContiguousIterator out_it(
-      out_remaining_shape, out_remaining_strides, out_remaining_shape.size());
-  for (int i = 0; i < n_rows; i++) {
-    const T* data_ptr = in.data<T>() + in_it.loc;
-    IdxT* idx_ptr = out.data<IdxT>() + out_it.loc;
-    in_it.step();
-    out_it.step();
-
-    StridedIterator st_(idx_ptr, out_stride, 0);
-    StridedIterator ed_(idx_ptr, out_stride, axis_size);
-
-    // Initialize with iota
-    std::iota(st_, ed_, IdxT(0));
-
-    // Sort according to vals
-    StridedIterator st(idx_ptr, out_stride, 0);
-    StridedIterator ed(idx_ptr, out_stride, axis_size);
-
-    std::stable_sort(st, ed, [data_ptr, in_stride](IdxT a, IdxT b) {
-      auto v1 = data_ptr[a * in_stride];
-      auto v2 = data_ptr[b * in_stride];
-      return v1 < v2 || (v1 == v2 && a < b);
-    });
-  }
+  // Perform sorting, the rows are split across threads
+  auto in_ptr = in.data<T>();
+  auto out_ptr = out.data<IdxT>();
+  auto sort_rows = [&](int64_t begin, int64_t end) {
+    ContiguousIterator in_it(
+        in_remaining_shape, in_remaining_strides, in_remaining_shape.size());
+    ContiguousIterator out_it(
+        out_remaining_shape,
+        out_remaining_strides,
+        out_remaining_shape.size());
+    in_it.seek(begin);
+    out_it.seek(begin);
+    for (int64_t i = begin; i < end; i++) {
+      const T* data_ptr = in_ptr + in_it.loc;
+      IdxT* idx_ptr = out_ptr + out_it.loc;
+      in_it.step();
+      out_it.step();
+
+      if constexpr (is_radix_sortable_v<T>) {
+        if (axis_size >= radix_sort_min_size) {
+          auto idx = radix_argsort<T, IdxT>(data_ptr, in_stride, axis_size);
+          for (int j = 0; j < axis_size; j++) {
+            idx_ptr[j * out_stride] = idx[j];
+          }
+          continue;
+        }
+      }
+
+      StridedIterator st_(idx_ptr, out_stride, 0);
+      StridedIterator ed_(idx_ptr, out_stride, axis_size);
+
+      // Initialize with iota
+      std::iota(st_, ed_, IdxT(0));
+
+      // Sort according to vals
+      StridedIterator st(idx_ptr, out_stride, 0);
+      StridedIterator ed(idx_ptr, out_stride, axis_size);
+
+      std::stable_sort(st, ed, [data_ptr, in_stride](IdxT a, IdxT b) {
+        auto v1 = data_ptr[a * in_stride];
+        auto v2 = data_ptr[b * in_stride];
+        return Less<T>{}(v1, v2) || (!Less<T>{}(v2, v1) && a < b);
+      });
+    }
+  };
+  cpu::parallel_for(n_rows, cpu::grain_size(axis_size), sort_rows);
 }
 
 template <typename T, typename IdxT = uint32_t>
@@ -213,19 +414,21 @@ void partition(const array& in, array& out, int axis, int kth) {
 
   kth = kth < 0 ? kth + axis_size : kth;
 
-  // Perform partition in place
-  ContiguousIterator src_it(
-      remaining_shape, remaining_strides, remaining_shape.size());
-  for (int i = 0; i < n_rows; i++) {
-    T* data_ptr = out.data<T>() + src_it.loc;
-    src_it.step();
-
-    StridedIterator st(data_ptr, axis_stride, 0);
-    StridedIterator md(data_ptr, axis_stride, kth);
-    StridedIterator ed(data_ptr, axis_stride, axis_size);
-
-    std::nth_element(st, md, ed);
-  }
+  // Perform partition in place, the rows are split across threads
+  auto out_ptr = out.data<T>();
+  auto partition_rows = [&](int64_t begin, int64_t end) {
+    ContiguousIterator src_it(
+        remaining_shape, remaining_strides, remaining_shape.size());
+    src_it.seek(begin);
+    for (int64_t i = begin; i < end; i++) {
+      T* data_ptr = out_ptr + src_it.loc;
+      src_it.step();
+
+      StridedIterator st(data_ptr, axis_stride, 0);
+      partition_row(st, kth, axis_size, Less<T>{});
+    }
+  };
+  cpu::parallel_for(n_rows, cpu::grain_size(axis_size), partition_rows);
 }
 
 template <typename T, typename IdxT = uint32_t>
@@ -255,34 +458,133 @@ void argpartition(const array& in, array& out, int axis, int kth) {
 
   kth = kth < 0 ? kth + axis_size : kth;
 
-  // Perform partition
-  ContiguousIterator in_it(
-      in_remaining_shape, in_remaining_strides, in_remaining_shape.size());
-  ContiguousIterator out_it(
-      out_remaining_shape, out_remaining_strides, out_remaining_shape.size());
-  for (int i = 0; i < n_rows; i++) {
-    const T* data_ptr = in.data<T>() + in_it.loc;
-    IdxT* idx_ptr = out.data<IdxT>() + out_it.loc;
-    in_it.step();
-    out_it.step();
-
-    StridedIterator st_(idx_ptr, out_stride, 0);
-    StridedIterator ed_(idx_ptr, out_stride, axis_size);
-
-    // Initialize with iota
-    std::iota(st_, ed_, IdxT(0));
-
-    // Sort according to vals
-    StridedIterator st(idx_ptr, out_stride, 0);
-    StridedIterator md(idx_ptr, out_stride, kth);
-    StridedIterator ed(idx_ptr, out_stride, axis_size);
-
-    std::nth_element(st, md, ed, [data_ptr, in_stride](IdxT a, IdxT b) {
-      auto v1 = data_ptr[a * in_stride];
-      auto v2 = data_ptr[b * in_stride];
-      return v1 < v2 || (v1 == v2 && a < b);
-    });
+  // Perform partition, the rows are split across threads
+  auto in_ptr = in.data<T>();
+  auto out_ptr = out.data<IdxT>();
+  auto partition_rows = [&](int64_t begin, int64_t end) {
+    ContiguousIterator in_it(
+        in_remaining_shape, in_remaining_strides, in_remaining_shape.size());
+    ContiguousIterator out_it(
+        out_remaining_shape,
+        out_remaining_strides,
+        out_remaining_shape.size());
+    in_it.seek(begin);
+    out_it.seek(begin);
+    for (int64_t i = begin; i < end; i++) {
+      const T* data_ptr = in_ptr + in_it.loc;
+      IdxT* idx_ptr = out_ptr + out_it.loc;
+      in_it.step();
+      out_it.step();
+
+      StridedIterator st_(idx_ptr, out_stride, 0);
+      StridedIterator ed_(idx_ptr, out_stride, axis_size);
+
+      // Initialize with iota
+      std::iota(st_, ed_, IdxT(0));
+
+      // Partition according to vals
+      StridedIterator st(idx_ptr, out_stride, 0);
+      partition_row(
+          st, kth, axis_size, [data_ptr, in_stride](IdxT a, IdxT b) {
+            auto v1 = data_ptr[a * in_stride];
+            auto v2 = data_ptr[b * in_stride];
+            return Less<T>{}(v1, v2) || (!Less<T>{}(v2, v1) && a < b);
+          });
+    }
+  };
+  cpu::parallel_for(n_rows, cpu::grain_size(axis_size), partition_rows);
+}
+
+template <typename T, typename IdxT = uint32_t>
+void topk(const array& in, std::vector<array>& outputs, int axis, int k) {
+  // Allocate outputs
+  auto& values = outputs[0];
+  auto& indices = outputs[1];
+  values.set_data(allocator::malloc_or_wait(values.nbytes()));
+  indices.set_data(allocator::malloc_or_wait(indices.nbytes()));
+  if (values.size() == 0) {
+    return;
   }
+
+  // Get axis, shape and stride info
+  size_t n_rows = in.size() / in.shape(axis);
+
+  auto in_remaining_shape = in.shape();
+  in_remaining_shape.erase(in_remaining_shape.begin() + axis);
+
+  auto in_remaining_strides = in.strides();
+  in_remaining_strides.erase(in_remaining_strides.begin() + axis);
+
+  auto out_remaining_shape = values.shape();
+  out_remaining_shape.erase(out_remaining_shape.begin() + axis);
+
+  auto out_remaining_strides = values.strides();
+  out_remaining_strides.erase(out_remaining_strides.begin() + axis);
+
+  auto in_stride = in.strides()[axis];
+  auto out_stride = values.strides()[axis];
+  int axis_size = in.shape(axis);
+
+  // Select the top k of each row, the rows are split across threads
+  auto in_ptr = in.data<T>();
+  auto values_ptr = values.data<T>();
+  auto indices_ptr = indices.data<IdxT>();
+  auto select_rows = [&](int64_t begin, int64_t end) {
+    ContiguousIterator in_it(
+        in_remaining_shape, in_remaining_strides, in_remaining_shape.size());
+    ContiguousIterator out_it(
+        out_remaining_shape,
+        out_remaining_strides,
+        out_remaining_shape.size());
+    in_it.seek(begin);
+    out_it.seek(begin);
+    std::vector<IdxT> selected;
+    for (int64_t i = begin; i < end; i++) {
+      const T* data_ptr = in_ptr + in_it.loc;
+      T* v_ptr = values_ptr + out_it.loc;
+      IdxT* idx_ptr = indices_ptr + out_it.loc;
+      in_it.step();
+      out_it.step();
+
+      // Larger values come first and ties keep the lower index
+      auto greater = [data_ptr, in_stride](IdxT a, IdxT b) {
+        auto v1 = data_ptr[a * in_stride];
+        auto v2 = data_ptr[b * in_stride];
+        return Less<T>{}(v2, v1) || (!Less<T>{}(v1, v2) && a < b);
+      };
+
+      if (int64_t(k) * partial_sort_ratio <= axis_size) {
+        // Keep the best k seen so far in a heap whose top is the worst of
+        // them so that most elements are rejected with one comparison
+        selected.resize(k);
+        std::iota(selected.begin(), selected.end(), IdxT(0));
+        std::make_heap(selected.begin(), selected.end(), greater);
+        for (IdxT j = k; j < static_cast<IdxT>(axis_size); j++) {
+          if (greater(j, selected[0])) {
+            std::pop_heap(selected.begin(), selected.end(), greater);
+            selected.back() = j;
+            std::push_heap(selected.begin(), selected.end(), greater);
+          }
+        }
+        std::sort_heap(selected.begin(), selected.end(), greater);
+      } else {
+        selected.resize(axis_size);
+        std::iota(selected.begin(), selected.end(), IdxT(0));
+        std::nth_element(
+            selected.begin(),
+            selected.begin() + k - 1,
+            selected.end(),
+            greater);
+        std::sort(selected.begin(), selected.begin() + k, greater);
+      }
+
+      for (int j = 0; j < k; j++) {
+        v_ptr[j * out_stride] = data_ptr[selected[j] * in_stride];
+        idx_ptr[j * out_stride] = selected[j];
+      }
+    }
+  };
+  cpu::parallel_for(n_rows, cpu::grain_size(axis_size), select_rows);
 }
 
 } // namespace
@@ -423,4 +725,38 @@ void Partition::eval(const std::vector<array>& inputs, array& out) {
   }
 }
 
+void TopK::eval(const std::vector<array>& inputs, std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  auto& in = inputs[0];
+
+  switch (in.dtype()) {
+    case bool_:
+      return topk<bool>(in, outputs, axis_, k_);
+    case uint8:
+      return topk<uint8_t>(in, outputs, axis_, k_);
+    case uint16:
+      return topk<uint16_t>(in, outputs, axis_, k_);
+    case uint32:
+      return topk<uint32_t>(in, outputs, axis_, k_);
+    case uint64:
+      return topk<uint64_t>(in, outputs, axis_, k_);
+    case int8:
+      return topk<int8_t>(in, outputs, axis_, k_);
+    case int16:
+      return topk<int16_t>(in, outputs, axis_, k_);
+    case int32:
+      return topk<int32_t>(in, outputs, axis_, k_);
+    case int64:
+      return topk<int64_t>(in, outputs, axis_, k_);
+    case float32:
+      return topk<float>(in, outputs, axis_, k_);
+    case float16:
+      return topk<float16_t>(in, outputs, axis_, k_);
+    case bfloat16:
+      return topk<bfloat16_t>(in, outputs, axis_, k_);
+    case complex64:
+      return topk<complex64_t>(in, outputs, axis_, k_);
+  }
+}
+
 } // namespace mlx::core
@@ -0,0 +1,210 @@
+// Copyright © 2024 Apple Inc.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "mlx/backend/common/parallel.h"
+#include "mlx/utils.h"
+
+namespace mlx::core::cpu {
+
+namespace {
+
+thread_local bool is_pool_worker = false;
+
+struct Job {
+  Job(int64_t n_tasks, const std::function<void(int64_t)>& fn)
+      : n_tasks(n_tasks), fn(fn) {}
+
+  // Run tasks until none are left to claim.
+  void work() {
+    int64_t i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < n_tasks) {
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == n_tasks) {
+        std::lock_guard<std::mutex> lk(mtx);
+        cond.notify_all();
+      }
+    }
+  }
+
+  bool exhausted() const {
+    return next.load(std::memory_order_relaxed) >= n_tasks;
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lk(mtx);
+    cond.wait(lk, [this] {
+      return done.load(std::memory_order_acquire) == n_tasks;
+    });
+  }
+
+  const int64_t n_tasks;
+  const std::function<void(int64_t)>& fn;
+  std::atomic<int64_t> next{0};
+  std::atomic<int64_t> done{0};
+  std::exception_ptr error;
+  std::mutex mtx;
+  std::condition_variable cond;
+};
+
+class ThreadPool {
+ public:
+  explicit ThreadPool(int n_threads) : stop_(false) {
+    // The caller takes part in every job so spawn one worker less.
+    for (int i = 1; i < n_threads; i++) {
+      workers_.emplace_back(&ThreadPool::thread_fn, this);
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto& w : workers_) {
+      w.join();
+    }
+  }
+
+  // Not copyable or moveable
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  int size() const {
+    return workers_.size() + 1;
+  }
+
+  void run(int64_t n_tasks, const std::function<void(int64_t)>& fn) {
+    auto job = std::make_shared<Job>(n_tasks, fn);
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      jobs_.push_back(job);
+    }
+    if (n_tasks - 1 >= static_cast<int64_t>(workers_.size())) {
+      cond_.notify_all();
+    } else {
+      for (int64_t i = 1; i < n_tasks; i++) {
+        cond_.notify_one();
+      }
+    }
+
+    job->work();
+
+    // Make sure no worker picks the job up after it is finished
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      auto it = std::find(jobs_.begin(), jobs_.end(), job);
+      if (it != jobs_.end()) {
+        jobs_.erase(it);
+      }
+    }
+    job->wait();
+
+    if (job->error) {
+      std::rethrow_exception(job->error);
+    }
+  }
+
+ private:
+  void thread_fn() {
+    is_pool_worker = true;
+    while (true) {
+      std::shared_ptr<Job> job;
+      {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cond_.wait(lk, [this] { return !jobs_.empty() || stop_; });
+        if (stop_ && jobs_.empty()) {
+          return;
+        }
+        job = jobs_.front();
+        if (job->exhausted()) {
+          jobs_.pop_front();
+          continue;
+        }
+      }
+      job->work();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::deque<std::shared_ptr<Job>> jobs_;
+  std::mutex mtx_;
+  std::condition_variable cond_;
+  bool stop_;
+};
+
+int default_num_threads() {
+  int n = env::cpu_num_threads();
+  if (n <= 0) {
+    n = std::thread::hardware_concurrency();
+  }
+  return std::max(n, 1);
+}
+
+struct PoolHolder {
+  std::mutex mtx;
+  std::shared_ptr<ThreadPool> pool;
+  std::atomic<int> n_threads{default_num_threads()};
+};
+
+PoolHolder& pool_holder() {
+  static PoolHolder holder;
+  return holder;
+}
+
+std::shared_ptr<ThreadPool> get_pool() {
+  auto& holder = pool_holder();
+  std::lock_guard<std::mutex> lk(holder.mtx);
+  int n_threads = holder.n_threads.load(std::memory_order_relaxed);
+  if (!holder.pool || holder.pool->size() != n_threads) {
+    holder.pool = std::make_shared<ThreadPool>(n_threads);
+  }
+  return holder.pool;
+}
+
+} // namespace
+
+int get_num_threads() {
+  return pool_holder().n_threads.load(std::memory_order_relaxed);
+}
+
+int set_num_threads(int num_threads) {
+  if (num_threads < 1) {
+    throw std::invalid_argument(
+        "[cpu::set_num_threads] The number of threads must be positive.");
+  }
+  // The pool is rebuilt lazily by the next parallel operation. Operations
+  // already running keep their own reference to the old pool.
+  return pool_holder().n_threads.exchange(num_threads);
+}
+
+bool in_parallel_region() {
+  return is_pool_worker;
+}
+
+void parallel_for_impl(
+    int64_t n_tasks,
+    const std::function<void(int64_t)>& fn) {
+  get_pool()->run(n_tasks, fn);
+}
+
+} // namespace mlx::core::cpu
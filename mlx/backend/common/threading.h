@@ -0,0 +1,24 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+namespace mlx::core::cpu {
+
+/* Get the number of threads used to parallelize a single CPU operation.
+ *
+ * The calling stream thread always participates in the work so this is one
+ * more than the number of worker threads in the pool.
+ * */
+int get_num_threads();
+
+/* Set the number of threads used to parallelize a single CPU operation.
+ *
+ * The default is the value of the ``MLX_CPU_NUM_THREADS`` environment
+ * variable or, if it is not set, the number of hardware threads. A value of
+ * ``1`` runs every CPU operation on the stream thread only.
+ *
+ * Returns the previous number of threads.
+ * */
+int set_num_threads(int num_threads);
+
+} // namespace mlx::core::cpu
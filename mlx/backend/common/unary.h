@@ -4,6 +4,8 @@
 
 #include "mlx/allocator.h"
 #include "mlx/array.h"
+#include "mlx/backend/common/parallel.h"
+#include "mlx/backend/common/simd/simd.h"
 #include "mlx/backend/common/utils.h"
 #include "mlx/utils.h"
 
@@ -26,6 +28,9 @@ void set_unary_output_data(const array& in, array& out) {
 
 template <typename T, typename U = T, typename Op>
 void unary_op(const T* a, U* out, Op op, size_t shape, size_t stride) {
+  if (stride == 1 && simd::unary(op, a, out, shape)) {
+    return;
+  }
   for (size_t i = 0; i < shape; i += 1) {
     out[i] = op(*a);
     a += stride;
@@ -38,9 +43,14 @@ void unary_op(const array& a, array& out, Op op) {
   if (a.flags().contiguous) {
     set_unary_output_data(a, out);
     U* dst = out.data<U>();
-    for (size_t i = 0; i < a.data_size(); ++i) {
-      dst[i] = op(a_ptr[i]);
-    }
+    cpu::parallel_for(a.data_size(), [&](int64_t begin, int64_t end) {
+      if (simd::unary(op, a_ptr + begin, dst + begin, end - begin)) {
+        return;
+      }
+      for (int64_t i = begin; i < end; ++i) {
+        dst[i] = op(a_ptr[i]);
+      }
+    });
   } else {
     out.set_data(allocator::malloc_or_wait(out.nbytes()));
     U* dst = out.data<U>();
@@ -50,11 +60,16 @@ void unary_op(const array& a, array& out, Op op) {
       unary_op(a_ptr, dst, op, shape, stride);
       return;
     }
-    ContiguousIterator it(a.shape(), a.strides(), a.ndim() - 1);
-    for (size_t elem = 0; elem < a.size(); elem += shape) {
-      unary_op(a_ptr + it.loc, dst + elem, op, shape, stride);
-      it.step();
-    }
+    int64_t n_rows = a.size() / std::max<size_t>(shape, 1);
+    int64_t grain = cpu::grain_size(shape);
+    cpu::parallel_for(n_rows, grain, [&](int64_t begin, int64_t end) {
+      ContiguousIterator it(a.shape(), a.strides(), a.ndim() - 1);
+      it.seek(begin);
+      for (int64_t i = begin; i < end; i++) {
+        unary_op(a_ptr + it.loc, dst + i * shape, op, shape, stride);
+        it.step();
+      }
+    });
   }
 }
 
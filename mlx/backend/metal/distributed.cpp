@@ -45,13 +45,20 @@ void AllReduce::eval_gpu(
     if (in.event().valid()) {
       in.event().wait();
     }
+    auto& input = in.data_shared_ptr() == nullptr ? out : in;
     switch (reduce_type) {
       case Sum:
-        distributed::detail::all_sum(
-            group, in.data_shared_ptr() == nullptr ? out : in, out);
+        distributed::detail::all_sum(group, input, out);
+        break;
+      case Max:
+        distributed::detail::all_max(group, input, out);
+        break;
+      case Min:
+        distributed::detail::all_min(group, input, out);
         break;
       default:
-        throw std::runtime_error("Only all reduce sum is supported for now");
+        throw std::runtime_error(
+            "Only all reduce sum, max and min are supported for now");
     }
     out.event().signal();
   };
@@ -81,6 +88,75 @@ void AllGather::eval_gpu(
   signal_and_wait(in, out, stream());
 }
 
+void ReduceScatter::eval_gpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+  auto& in = inputs[0];
+  auto& out = outputs[0];
+
+  out.set_data(allocator::malloc_or_wait(out.nbytes()));
+
+  auto task = [in = in, out = out, group = group()]() mutable {
+    if (in.event().valid()) {
+      in.event().wait();
+    }
+    distributed::detail::reduce_scatter(group, in, out);
+    out.event().signal();
+  };
+  scheduler::enqueue(detail::communication_stream(), std::move(task));
+  signal_and_wait(in, out, stream());
+}
+
+void Broadcast::eval_gpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+
+  auto& in = inputs[0];
+  auto& out = outputs[0];
+  if (in.is_donatable()) {
+    out.move_shared_buffer(in);
+  } else {
+    out.set_data(allocator::malloc_or_wait(out.nbytes()));
+  }
+
+  auto task = [in = in, out = out, group = group(), root = root_]() mutable {
+    if (in.event().valid()) {
+      in.event().wait();
+    }
+    distributed::detail::broadcast(
+        group, in.data_shared_ptr() == nullptr ? out : in, out, root);
+    out.event().signal();
+  };
+  scheduler::enqueue(detail::communication_stream(), std::move(task));
+
+  signal_and_wait(in, out, stream());
+}
+
+void AllToAll::eval_gpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+  auto& in = inputs[0];
+  auto& out = outputs[0];
+
+  out.set_data(allocator::malloc_or_wait(out.nbytes()));
+
+  auto task = [in = in, out = out, group = group()]() mutable {
+    if (in.event().valid()) {
+      in.event().wait();
+    }
+    distributed::detail::all_to_all(group, in, out);
+    out.event().signal();
+  };
+  scheduler::enqueue(detail::communication_stream(), std::move(task));
+  signal_and_wait(in, out, stream());
+}
+
 void Send::eval_gpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
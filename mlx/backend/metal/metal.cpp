@@ -4,6 +4,7 @@
 #include "mlx/backend/metal/device.h"
 #include "mlx/backend/metal/utils.h"
 #include "mlx/primitives.h"
+#include "mlx/profiler.h"
 #include "mlx/scheduler.h"
 #include "mlx/utils.h"
 
@@ -47,6 +48,7 @@ std::function<void()> make_task(array arr, bool signal) {
       }
 
       debug_set_primitive_buffer_label(command_buffer, arr.primitive());
+      profiler::detail::PrimitiveScope profile(arr);
       arr.primitive().eval_gpu(arr.inputs(), outputs);
     }
     std::vector<std::shared_ptr<array::Data>> buffers;
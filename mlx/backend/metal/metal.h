@@ -13,6 +13,9 @@ namespace mlx::core::metal {
 bool is_available();
 
 /* Get the actively used memory in bytes.
+ *
+ * Without the Metal backend this and the other memory functions below apply
+ * to the CPU allocator.
  *
  * Note, this will not always match memory use reported by the system because
  * it does not include cached memory buffers.
@@ -417,6 +417,17 @@ void SVD::eval_gpu(
   throw std::runtime_error("[SVD::eval_gpu] Metal SVD NYI.");
 }
 
+void GatherAxis::eval_gpu(const std::vector<array>& inputs, array& out) {
+  throw std::runtime_error(
+      "[GatherAxis::eval_gpu] Metal gather along axis NYI.");
+}
+
+void TopK::eval_gpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  throw std::runtime_error("[TopK::eval_gpu] Metal top-k NYI.");
+}
+
 void Inverse::eval_gpu(const std::vector<array>& inputs, array& output) {
   throw std::runtime_error("[Inverse::eval_gpu] Metal inversion NYI.");
 }
@@ -62,6 +62,7 @@ NO_CPU(Flatten)
 NO_CPU(Floor)
 NO_CPU(Full)
 NO_CPU(Gather)
+NO_CPU(GatherAxis)
 NO_CPU(GatherMM)
 NO_CPU(GatherQMM)
 NO_CPU(Greater)
@@ -113,6 +114,7 @@ NO_CPU(Subtract)
 NO_CPU_MULTI(SVD)
 NO_CPU(Tan)
 NO_CPU(Tanh)
+NO_CPU_MULTI(TopK)
 NO_CPU(Transpose)
 NO_CPU(Unflatten)
 NO_CPU(Inverse)
@@ -0,0 +1,15 @@
+// Copyright © 2024 Apple Inc.
+
+#include "mlx/backend/common/threading.h"
+
+namespace mlx::core::cpu {
+
+// There is no intra-op pool without the CPU backend.
+int get_num_threads() {
+  return 1;
+}
+int set_num_threads(int) {
+  return 1;
+}
+
+} // namespace mlx::core::cpu
@@ -4,9 +4,16 @@
 
 namespace mlx::core::allocator {
 
+CommonAllocator& common_allocator() {
+  // By creating the |allocator_| on heap, the destructor of CommonAllocator
+  // will not be called on exit and buffers in the cache will be leaked. This
+  // avoids freeing buffers that arrays destroyed later at exit still hold.
+  static CommonAllocator* allocator_ = new CommonAllocator;
+  return *allocator_;
+}
+
 Allocator& allocator() {
-  static CommonAllocator allocator_;
-  return allocator_;
+  return common_allocator();
 }
 
 void* Buffer::raw_ptr() {
@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 
+#include "mlx/allocator.h"
 #include "mlx/backend/metal/metal.h"
 #include "mlx/backend/metal/metal_impl.h"
 namespace mlx::core::metal {
@@ -29,22 +30,24 @@ std::function<void()> make_synchronize_task(
       " without metal backend");
 }
 
-// No-ops when Metal is not available.
+// Without Metal the memory stats and limits apply to the CPU allocator.
 size_t get_active_memory() {
-  return 0;
+  return allocator::common_allocator().get_active_memory();
 }
 size_t get_peak_memory() {
-  return 0;
+  return allocator::common_allocator().get_peak_memory();
+}
+void reset_peak_memory() {
+  allocator::common_allocator().reset_peak_memory();
 }
-void reset_peak_memory() {}
 size_t get_cache_memory() {
-  return 0;
+  return allocator::common_allocator().get_cache_memory();
 }
-size_t set_memory_limit(size_t, bool) {
-  return 0;
+size_t set_memory_limit(size_t limit, bool relaxed) {
+  return allocator::common_allocator().set_memory_limit(limit, relaxed);
 }
-size_t set_cache_limit(size_t) {
-  return 0;
+size_t set_cache_limit(size_t limit) {
+  return allocator::common_allocator().set_cache_limit(limit);
 }
 size_t set_wired_limit(size_t) {
   return 0;
@@ -52,7 +55,9 @@ size_t set_wired_limit(size_t) {
 
 void start_capture(std::string) {}
 void stop_capture() {}
-void clear_cache() {}
+void clear_cache() {
+  allocator::common_allocator().clear_cache();
+}
 
 std::unordered_map<std::string, std::variant<std::string, size_t>>
 device_info() {
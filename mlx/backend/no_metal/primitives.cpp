@@ -62,6 +62,7 @@ NO_GPU(Flatten)
 NO_GPU(Floor)
 NO_GPU(Full)
 NO_GPU(Gather)
+NO_GPU(GatherAxis)
 NO_GPU(GatherMM)
 NO_GPU(GatherQMM)
 NO_GPU(Greater)
@@ -113,6 +114,7 @@ NO_GPU(Subtract)
 NO_GPU_MULTI(SVD)
 NO_GPU(Tan)
 NO_GPU(Tanh)
+NO_GPU_MULTI(TopK)
 NO_GPU(Transpose)
 NO_GPU(Unflatten)
 NO_GPU(Inverse)
@@ -134,6 +136,9 @@ NO_GPU_MULTI(CustomKernel)
 namespace distributed {
 NO_GPU_MULTI(AllReduce)
 NO_GPU_MULTI(AllGather)
+NO_GPU_MULTI(ReduceScatter)
+NO_GPU_MULTI(Broadcast)
+NO_GPU_MULTI(AllToAll)
 NO_GPU_MULTI(Send)
 NO_GPU_MULTI(Recv)
 } // namespace distributed
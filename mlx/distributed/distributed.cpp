@@ -0,0 +1,172 @@
+// Copyright © 2024 Apple Inc.
+
+#include <cstring>
+#include <sstream>
+
+#include "mlx/distributed/distributed.h"
+#include "mlx/distributed/distributed_impl.h"
+#include "mlx/distributed/mpi/mpi.h"
+#include "mlx/distributed/ring/ring.h"
+
+namespace mlx::core::distributed {
+
+namespace detail {
+
+Stream communication_stream() {
+  static Stream comm_stream = new_stream(Device::cpu);
+  return comm_stream;
+}
+
+void all_sum(Group group, const array& input, array& output) {
+  group.raw_group()->all_sum(input, output);
+}
+
+void all_max(Group group, const array& input, array& output) {
+  group.raw_group()->all_max(input, output);
+}
+
+void all_min(Group group, const array& input, array& output) {
+  group.raw_group()->all_min(input, output);
+}
+
+void all_gather(Group group, const array& input, array& output) {
+  group.raw_group()->all_gather(input, output);
+}
+
+void reduce_scatter(Group group, const array& input, array& output) {
+  group.raw_group()->reduce_scatter(input, output);
+}
+
+void broadcast(Group group, const array& input, array& output, int root) {
+  group.raw_group()->broadcast(input, output, root);
+}
+
+void all_to_all(Group group, const array& input, array& output) {
+  group.raw_group()->all_to_all(input, output);
+}
+
+void send(Group group, const array& input, int dst) {
+  group.raw_group()->send(input, dst);
+}
+
+void recv(Group group, array& out, int src) {
+  group.raw_group()->recv(out, src);
+}
+
+namespace {
+
+// The group of a single process when no backend could be initialized. The
+// ops never reach it since they return early for groups of size 1.
+class EmptyGroup : public GroupImpl {
+ public:
+  int rank() override {
+    return 0;
+  }
+
+  int size() override {
+    return 1;
+  }
+
+  std::shared_ptr<GroupImpl> split(int color, int key = -1) override {
+    throw std::runtime_error("Cannot split the distributed group further.");
+  }
+
+  void all_sum(const array& input, array& output) override {
+    copy_to(input, output);
+  }
+
+  void all_max(const array& input, array& output) override {
+    copy_to(input, output);
+  }
+
+  void all_min(const array& input, array& output) override {
+    copy_to(input, output);
+  }
+
+  void all_gather(const array& input, array& output) override {
+    copy_to(input, output);
+  }
+
+  void reduce_scatter(const array& input, array& output) override {
+    copy_to(input, output);
+  }
+
+  void broadcast(const array& input, array& output, int root) override {
+    copy_to(input, output);
+  }
+
+  void all_to_all(const array& input, array& output) override {
+    copy_to(input, output);
+  }
+
+  void send(const array& input, int dst) override {
+    throw std::runtime_error(
+        "Communication not available in a singleton group.");
+  }
+
+  void recv(array& out, int src) override {
+    throw std::runtime_error(
+        "Communication not available in a singleton group.");
+  }
+
+ private:
+  void copy_to(const array& input, array& output) {
+    if (input.data<void>() != output.data<void>()) {
+      std::memcpy(output.data<void>(), input.data<void>(), input.nbytes());
+    }
+  }
+};
+
+} // namespace
+
+} // namespace detail
+
+int Group::rank() {
+  return group_->rank();
+}
+
+int Group::size() {
+  return group_->size();
+}
+
+Group Group::split(int color, int key /* = -1 */) {
+  return Group(group_->split(color, key));
+}
+
+bool is_available() {
+  return mpi::is_available() || ring::is_available();
+}
+
+Group init(bool strict /* = false */, const std::string& bk /* = "any" */) {
+  if (bk != "any" && bk != "mpi" && bk != "ring") {
+    std::ostringstream msg;
+    msg << "[distributed::init] Unknown backend " << bk
+        << ", expected one of any, mpi or ring.";
+    throw std::invalid_argument(msg.str());
+  }
+
+  // The backends keep their global group so initializing again returns it
+  std::shared_ptr<detail::GroupImpl> group{nullptr};
+  if (bk == "mpi" || bk == "any") {
+    group = mpi::init(strict && bk == "mpi");
+  }
+  if (group == nullptr && (bk == "ring" || bk == "any")) {
+    group = ring::init(strict && bk == "ring");
+  }
+  if (group == nullptr) {
+    if (strict) {
+      std::ostringstream msg;
+      msg << "[distributed::init] Couldn't initialize the " << bk
+          << " backend.";
+      throw std::runtime_error(msg.str());
+    }
+    group = std::make_shared<detail::EmptyGroup>();
+  }
+
+  // Ensure the communication stream is alive before
+  // the graph is evaluated
+  detail::communication_stream();
+  return Group(group);
+}
+
+} // namespace mlx::core::distributed
@@ -3,11 +3,18 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "mlx/array.h"
 
 namespace mlx::core::distributed {
 
+namespace detail {
+
+class GroupImpl;
+
+} // namespace detail
+
 /* Check if a communication backend is available */
 bool is_available();
 
@@ -17,7 +24,7 @@ bool is_available();
  * order to define more granular communication.
  */
 struct Group {
-  Group(std::shared_ptr<void> group) : group_(group) {}
+  Group(std::shared_ptr<detail::GroupImpl> group) : group_(std::move(group)) {}
 
   int rank();
   int size();
@@ -32,12 +39,12 @@ struct Group {
    */
   Group split(int color, int key = -1);
 
-  const std::shared_ptr<void>& raw_group() {
+  const std::shared_ptr<detail::GroupImpl>& raw_group() {
     return group_;
   }
 
  private:
-  std::shared_ptr<void> group_{nullptr};
+  std::shared_ptr<detail::GroupImpl> group_{nullptr};
 };
 
 /**
@@ -47,7 +54,10 @@ struct Group {
  * If strict is true then throw an error if we couldn't initialize the
  * distributed subsystem. Otherwise simply return a singleton group which will
  * render communication operations as no-op.
+ *
+ * The backend can be "mpi", "ring" or "any" in which case the first one that
+ * can be initialized is used, trying MPI first.
  */
-Group init(bool strict = false);
+Group init(bool strict = false, const std::string& bk = "any");
 
 } // namespace mlx::core::distributed
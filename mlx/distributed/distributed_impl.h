@@ -6,15 +6,53 @@
 
 namespace mlx::core::distributed::detail {
 
+/**
+ * Abstract base class of a communication backend. The collective operations
+ * are called from the communication stream with allocated outputs.
+ */
+class GroupImpl {
+ public:
+  virtual ~GroupImpl() {}
+
+  virtual int rank() = 0;
+  virtual int size() = 0;
+  virtual std::shared_ptr<GroupImpl> split(int color, int key = -1) = 0;
+
+  virtual void all_sum(const array& input, array& output) = 0;
+  virtual void all_max(const array& input, array& output) = 0;
+  virtual void all_min(const array& input, array& output) = 0;
+  virtual void all_gather(const array& input, array& output) = 0;
+  virtual void reduce_scatter(const array& input, array& output) = 0;
+  virtual void broadcast(const array& input, array& output, int root) = 0;
+  virtual void all_to_all(const array& input, array& output) = 0;
+  virtual void send(const array& input, int dst) = 0;
+  virtual void recv(array& out, int src) = 0;
+};
+
 /* Return the communication stream. */
 Stream communication_stream();
 
 /* Perform an all reduce sum operation */
 void all_sum(Group group, const array& input, array& output);
 
+/* Perform an all reduce max operation */
+void all_max(Group group, const array& input, array& output);
+
+/* Perform an all reduce min operation */
+void all_min(Group group, const array& input, array& output);
+
 /* Perform an all gather operation */
 void all_gather(Group group, const array& input, array& output);
 
+/* Sum the inputs and keep the slice of the first axis owned by this rank */
+void reduce_scatter(Group group, const array& input, array& output);
+
+/* Copy the input of the root rank to the output of every rank */
+void broadcast(Group group, const array& input, array& output, int root);
+
+/* Exchange the i-th slice of the first axis with the i-th rank */
+void all_to_all(Group group, const array& input, array& output);
+
 /** Send an array to the dst rank */
 void send(Group group, const array& input, int dst);
 
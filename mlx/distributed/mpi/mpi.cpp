@@ -3,10 +3,13 @@
 #include <dlfcn.h>
 #include <mpi.h>
 
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
 #include "mlx/backend/common/copy.h"
-#include "mlx/distributed/distributed.h"
-#include "mlx/distributed/distributed_impl.h"
-#include "mlx/scheduler.h"
+#include "mlx/distributed/mpi/mpi.h"
+#include "mlx/utils.h"
 
 #define LOAD_SYMBOL(symbol, variable)                              \
   {                                                                \
@@ -18,7 +21,7 @@
     }                                                              \
   }
 
-namespace mlx::core::distributed {
+namespace mlx::core::distributed::mpi {
 
 namespace {
 
@@ -51,6 +54,40 @@ void simple_sum(
 template void simple_sum<float16_t>(void*, void*, int*, MPI_Datatype*);
 template void simple_sum<bfloat16_t>(void*, void*, int*, MPI_Datatype*);
 
+template <typename T>
+void simple_max(
+    void* input,
+    void* accumulator,
+    int* len,
+    MPI_Datatype* datatype) {
+  T* in = (T*)input;
+  T* acc = (T*)accumulator;
+  int N = *len;
+
+  while (N-- > 0) {
+    *acc = (*in > *acc) ? *in : *acc;
+    acc++;
+    in++;
+  }
+}
+
+template <typename T>
+void simple_min(
+    void* input,
+    void* accumulator,
+    int* len,
+    MPI_Datatype* datatype) {
+  T* in = (T*)input;
+  T* acc = (T*)accumulator;
+  int N = *len;
+
+  while (N-- > 0) {
+    *acc = (*in < *acc) ? *in : *acc;
+    acc++;
+    in++;
+  }
+}
+
 struct MPIWrapper {
   MPIWrapper() {
     initialized_ = false;
@@ -67,8 +104,13 @@ struct MPIWrapper {
     LOAD_SYMBOL(MPI_Comm_size, size);
     LOAD_SYMBOL(MPI_Comm_split, comm_split);
     LOAD_SYMBOL(MPI_Comm_free, comm_free);
+    LOAD_SYMBOL(MPI_Get_processor_name, processor_name);
     LOAD_SYMBOL(MPI_Allreduce, all_reduce);
+    LOAD_SYMBOL(MPI_Reduce, reduce);
     LOAD_SYMBOL(MPI_Allgather, all_gather);
+    LOAD_SYMBOL(MPI_Reduce_scatter_block, reduce_scatter);
+    LOAD_SYMBOL(MPI_Bcast, broadcast);
+    LOAD_SYMBOL(MPI_Alltoall, all_to_all);
     LOAD_SYMBOL(MPI_Send, send);
     LOAD_SYMBOL(MPI_Recv, recv);
     LOAD_SYMBOL(MPI_Type_contiguous, mpi_type_contiguous);
@@ -80,6 +122,8 @@ struct MPIWrapper {
 
     // Ops
     LOAD_SYMBOL(ompi_mpi_op_sum, op_sum_);
+    LOAD_SYMBOL(ompi_mpi_op_max, op_max_);
+    LOAD_SYMBOL(ompi_mpi_op_min, op_min_);
 
     // Datatypes
     LOAD_SYMBOL(ompi_mpi_c_bool, mpi_bool_);
@@ -117,6 +161,16 @@ struct MPIWrapper {
       mpi_op_create(&simple_sum<float16_t>, 1, &op_sum_f16_);
       mpi_op_create(&simple_sum<bfloat16_t>, 1, &op_sum_bf16_);
 
+      // Custom max and min ops for the types MPI can't compare
+      mpi_op_create(&simple_max<float16_t>, 1, &op_max_f16_);
+      mpi_op_create(&simple_max<bfloat16_t>, 1, &op_max_bf16_);
+      mpi_op_create(&simple_max<bool>, 1, &op_max_bool_);
+      mpi_op_create(&simple_max<complex64_t>, 1, &op_max_c64_);
+      mpi_op_create(&simple_min<float16_t>, 1, &op_min_f16_);
+      mpi_op_create(&simple_min<bfloat16_t>, 1, &op_min_bf16_);
+      mpi_op_create(&simple_min<bool>, 1, &op_min_bool_);
+      mpi_op_create(&simple_min<complex64_t>, 1, &op_min_c64_);
+
       initialized_ = true;
     }
 
@@ -175,6 +229,36 @@ struct MPIWrapper {
     }
   }
 
+  MPI_Op op_max(const array& arr) {
+    switch (arr.dtype()) {
+      case float16:
+        return op_max_f16_;
+      case bfloat16:
+        return op_max_bf16_;
+      case bool_:
+        return op_max_bool_;
+      case complex64:
+        return op_max_c64_;
+      default:
+        return op_max_;
+    }
+  }
+
+  MPI_Op op_min(const array& arr) {
+    switch (arr.dtype()) {
+      case float16:
+        return op_min_f16_;
+      case bfloat16:
+        return op_min_bf16_;
+      case bool_:
+        return op_min_bool_;
+      case complex64:
+        return op_min_c64_;
+      default:
+        return op_min_;
+    }
+  }
+
   void* libmpi_handle_;
 
   // API
@@ -182,7 +266,9 @@ struct MPIWrapper {
   int (*finalize)();
   int (*rank)(MPI_Comm, int*);
   int (*size)(MPI_Comm, int*);
+  int (*processor_name)(char*, int*);
   int (*all_reduce)(const void*, void*, int, MPI_Datatype, MPI_Op, MPI_Comm);
+  int (*reduce)(const void*, void*, int, MPI_Datatype, MPI_Op, int, MPI_Comm);
   int (*all_gather)(
       const void*,
       int,
@@ -191,6 +277,22 @@ struct MPIWrapper {
       int,
       MPI_Datatype,
       MPI_Comm);
+  int (*reduce_scatter)(
+      const void*,
+      void*,
+      int,
+      MPI_Datatype,
+      MPI_Op,
+      MPI_Comm);
+  int (*broadcast)(void*, int, MPI_Datatype, int, MPI_Comm);
+  int (*all_to_all)(
+      const void*,
+      int,
+      MPI_Datatype,
+      void*,
+      int,
+      MPI_Datatype,
+      MPI_Comm);
   int (*comm_split)(MPI_Comm, int, int, MPI_Comm*);
   int (*comm_free)(MPI_Comm*);
   int (*send)(const void*, int, MPI_Datatype, int, int, MPI_Comm);
@@ -203,6 +305,16 @@ struct MPIWrapper {
   MPI_Op op_sum_;
   MPI_Op op_sum_f16_;
   MPI_Op op_sum_bf16_;
+  MPI_Op op_max_;
+  MPI_Op op_max_f16_;
+  MPI_Op op_max_bf16_;
+  MPI_Op op_max_bool_;
+  MPI_Op op_max_c64_;
+  MPI_Op op_min_;
+  MPI_Op op_min_f16_;
+  MPI_Op op_min_bf16_;
+  MPI_Op op_min_bool_;
+  MPI_Op op_min_c64_;
 
   // Datatypes
   MPI_Datatype mpi_bool_;
@@ -233,11 +345,21 @@ MPIWrapper& mpi() {
   return wrapper;
 }
 
-struct MPIGroupImpl {
-  MPIGroupImpl() : comm_(nullptr), global_(true), rank_(0), size_(1) {}
-  MPIGroupImpl(MPI_Comm comm, bool global)
-      : comm_(comm), global_(global), rank_(-1), size_(-1) {}
-  ~MPIGroupImpl() {
+class MPIGroup : public GroupImpl {
+ public:
+  MPIGroup(MPI_Comm comm, bool global)
+      : comm_(comm),
+        global_(global),
+        rank_(-1),
+        size_(-1),
+        topology_known_(false),
+        hierarchical_(false) {}
+
+  virtual ~MPIGroup() {
+    if (hierarchical_) {
+      mpi().comm_free(&node_comm_);
+      mpi().comm_free(&leader_comm_);
+    }
     if (global_) {
       mpi().finalize_safe();
     } else {
@@ -245,137 +367,242 @@ struct MPIGroupImpl {
     }
   }
 
-  MPI_Comm comm() {
-    return comm_;
-  }
-
-  int rank() {
+  int rank() override {
     if (rank_ < 0) {
       mpi().rank(comm_, &rank_);
     }
     return rank_;
   }
 
-  int size() {
+  int size() override {
     if (size_ < 0) {
       mpi().size(comm_, &size_);
     }
     return size_;
   }
 
- private:
-  MPI_Comm comm_;
-  bool global_;
-  int rank_;
-  int size_;
-};
+  std::shared_ptr<GroupImpl> split(int color, int key = -1) override {
+    key = (key < 0) ? rank() : key;
 
-MPI_Comm to_comm(Group& group) {
-  return std::static_pointer_cast<MPIGroupImpl>(group.raw_group())->comm();
-}
+    MPI_Comm new_comm;
+    int result = mpi().comm_split(comm_, color, key, &new_comm);
+    if (result != MPI_SUCCESS) {
+      throw std::runtime_error("MPI could not split this group");
+    }
 
-} // namespace
+    return std::make_shared<MPIGroup>(new_comm, false);
+  }
 
-int Group::rank() {
-  return std::static_pointer_cast<MPIGroupImpl>(group_)->rank();
-}
+  void all_sum(const array& input, array& output) override {
+    all_reduce(input, output, mpi().op_sum(input));
+  }
 
-int Group::size() {
-  return std::static_pointer_cast<MPIGroupImpl>(group_)->size();
-}
+  void all_max(const array& input, array& output) override {
+    all_reduce(input, output, mpi().op_max(input));
+  }
 
-Group Group::split(int color, int key) {
-  auto mpi_group = std::static_pointer_cast<MPIGroupImpl>(group_);
+  void all_min(const array& input, array& output) override {
+    all_reduce(input, output, mpi().op_min(input));
+  }
 
-  key = (key < 0) ? rank() : key;
+  void all_gather(const array& input_, array& output) override {
+    array input = ensure_row_contiguous(input_);
+    mpi().all_gather(
+        input.data<void>(),
+        input.size(),
+        mpi().datatype(input),
+        output.data<void>(),
+        input.size(),
+        mpi().datatype(output),
+        comm_);
+  }
 
-  MPI_Comm new_comm;
-  int result = mpi().comm_split(mpi_group->comm(), color, key, &new_comm);
-  if (result != MPI_SUCCESS) {
-    throw std::runtime_error("MPI could not split this group");
+  void reduce_scatter(const array& input_, array& output) override {
+    array input = ensure_row_contiguous(input_);
+    mpi().reduce_scatter(
+        input.data<void>(),
+        output.data<void>(),
+        output.size(),
+        mpi().datatype(input),
+        mpi().op_sum(input),
+        comm_);
   }
 
-  return Group(std::make_shared<MPIGroupImpl>(new_comm, false));
-}
+  void broadcast(const array& input_, array& output, int root) override {
+    array input = ensure_row_contiguous(input_);
+    if (input.data<void>() != output.data<void>()) {
+      std::memcpy(output.data<void>(), input.data<void>(), input.nbytes());
+    }
+    mpi().broadcast(
+        output.data<void>(),
+        output.size(),
+        mpi().datatype(output),
+        root,
+        comm_);
+  }
 
-bool is_available() {
-  return mpi().is_available();
-}
+  void all_to_all(const array& input_, array& output) override {
+    array input = ensure_row_contiguous(input_);
+    mpi().all_to_all(
+        input.data<void>(),
+        input.size() / size(),
+        mpi().datatype(input),
+        output.data<void>(),
+        output.size() / size(),
+        mpi().datatype(output),
+        comm_);
+  }
 
-Group init(bool strict /* = false */) {
-  static std::shared_ptr<MPIGroupImpl> global_group = nullptr;
+  void send(const array& input_, int dst) override {
+    array input = ensure_row_contiguous(input_);
+    mpi().send(
+        input.data<void>(),
+        input.size(),
+        mpi().datatype(input),
+        dst,
+        0,
+        comm_);
+  }
 
-  if (global_group == nullptr) {
-    if (!mpi().init_safe()) {
-      if (strict) {
-        throw std::runtime_error("Cannot initialize MPI");
+  void recv(array& out, int src) override {
+    MPI_Status status;
+    mpi().recv(
+        out.data<void>(),
+        out.size(),
+        mpi().datatype(out),
+        src,
+        MPI_ANY_TAG,
+        comm_,
+        &status);
+  }
+
+ private:
+  void all_reduce(const array& input_, array& output, MPI_Op op) {
+    array input = ensure_row_contiguous(input_);
+    if (hierarchical()) {
+      hierarchical_all_reduce(input, output, op);
+      return;
+    }
+    mpi().all_reduce(
+        (input.data<void>() == output.data<void>()) ? MPI_IN_PLACE
+                                                    : input.data<void>(),
+        output.data<void>(),
+        input.size(),
+        mpi().datatype(input),
+        op,
+        comm_);
+  }
+
+  // Reduce to the first rank of each host, all reduce across those ranks and
+  // broadcast the result back so that only one copy of the data goes over
+  // the network per host.
+  void hierarchical_all_reduce(const array& input, array& output, MPI_Op op) {
+    bool leader = node_rank_ == 0;
+    bool in_place = input.data<void>() == output.data<void>();
+    mpi().reduce(
+        (leader && in_place) ? MPI_IN_PLACE : input.data<void>(),
+        output.data<void>(),
+        input.size(),
+        mpi().datatype(input),
+        op,
+        0,
+        node_comm_);
+    if (leader) {
+      mpi().all_reduce(
+          MPI_IN_PLACE,
+          output.data<void>(),
+          output.size(),
+          mpi().datatype(output),
+          op,
+          leader_comm_);
+    }
+    mpi().broadcast(
+        output.data<void>(),
+        output.size(),
+        mpi().datatype(output),
+        0,
+        node_comm_);
+  }
+
+  // Find out which ranks share a host the first time a reduction runs. It is
+  // only worth splitting the reduction when there are several hosts and at
+  // least one of them runs more than one rank.
+  bool hierarchical() {
+    if (topology_known_) {
+      return hierarchical_;
+    }
+    topology_known_ = true;
+    if (!env::distributed_hierarchical() || size() < 3) {
+      return false;
+    }
+
+    std::vector<char> names(size() * MPI_MAX_PROCESSOR_NAME, 0);
+    char* name = names.data() + rank() * MPI_MAX_PROCESSOR_NAME;
+    int length;
+    mpi().processor_name(name, &length);
+    mpi().all_gather(
+        MPI_IN_PLACE,
+        0,
+        mpi().mpi_uint8_,
+        names.data(),
+        MPI_MAX_PROCESSOR_NAME,
+        mpi().mpi_uint8_,
+        comm_);
+
+    // Color every rank by the first rank on the same host
+    std::unordered_map<std::string, int> hosts;
+    int color = -1;
+    for (int i = 0; i < size(); i++) {
+      auto it = hosts.emplace(names.data() + i * MPI_MAX_PROCESSOR_NAME, i);
+      if (i == rank()) {
+        color = it.first->second;
       }
-      global_group = std::make_shared<MPIGroupImpl>();
-    } else {
-      global_group = std::make_shared<MPIGroupImpl>(mpi().world(), true);
     }
+    int num_hosts = hosts.size();
+    if (num_hosts == 1 || num_hosts == size()) {
+      return false;
+    }
+
+    mpi().comm_split(comm_, color, rank(), &node_comm_);
+    mpi().rank(node_comm_, &node_rank_);
+    mpi().comm_split(comm_, node_rank_ == 0 ? 0 : 1, rank(), &leader_comm_);
+    hierarchical_ = true;
+
+    return true;
   }
 
-  // Ensure the communication stream is alive before
-  // the graph is evaluated
-  detail::communication_stream();
-  return Group(global_group);
-}
+  MPI_Comm comm_;
+  bool global_;
+  int rank_;
+  int size_;
 
-namespace detail {
+  bool topology_known_;
+  bool hierarchical_;
+  MPI_Comm node_comm_;
+  MPI_Comm leader_comm_;
+  int node_rank_;
+};
 
-Stream communication_stream() {
-  static Stream comm_stream = new_stream(Device::cpu);
-  return comm_stream;
-}
+} // namespace
 
-void all_sum(Group group, const array& input_, array& output) {
-  array input = ensure_row_contiguous(input_);
-  mpi().all_reduce(
-      (input.data<void>() == output.data<void>()) ? MPI_IN_PLACE
-                                                  : input.data<void>(),
-      output.data<void>(),
-      input.size(),
-      mpi().datatype(input),
-      mpi().op_sum(input),
-      to_comm(group));
+bool is_available() {
+  return mpi().is_available();
 }
 
-void all_gather(Group group, const array& input_, array& output) {
-  array input = ensure_row_contiguous(input_);
-  mpi().all_gather(
-      input.data<void>(),
-      input.size(),
-      mpi().datatype(input),
-      output.data<void>(),
-      input.size(),
-      mpi().datatype(output),
-      to_comm(group));
-}
+std::shared_ptr<GroupImpl> init(bool strict /* = false */) {
+  static std::shared_ptr<MPIGroup> global_group = nullptr;
 
-void send(Group group, const array& input_, int dst) {
-  array input = ensure_row_contiguous(input_);
-  mpi().send(
-      input.data<void>(),
-      input.size(),
-      mpi().datatype(input),
-      dst,
-      0,
-      to_comm(group));
-}
+  if (global_group == nullptr) {
+    if (!mpi().init_safe()) {
+      if (strict) {
+        throw std::runtime_error("Cannot initialize MPI");
+      }
+      return nullptr;
+    }
+    global_group = std::make_shared<MPIGroup>(mpi().world(), true);
+  }
 
-void recv(Group group, array& out, int src) {
-  MPI_Status status;
-  mpi().recv(
-      out.data<void>(),
-      out.size(),
-      mpi().datatype(out),
-      src,
-      MPI_ANY_TAG,
-      to_comm(group),
-      &status);
+  return global_group;
 }
 
-} // namespace detail
-
-} // namespace mlx::core::distributed
+} // namespace mlx::core::distributed::mpi
@@ -4,6 +4,7 @@
 
 #include "mlx/distributed/ops.h"
 #include "mlx/distributed/primitives.h"
+#include "mlx/ops.h"
 
 namespace mlx::core::distributed {
 
@@ -17,12 +18,33 @@ Group to_group(std::optional<Group> group) {
   }
 }
 
-} // namespace
+// Communication on the CPU runs on its own stream, unless a stream is given
+// explicitly, so that it overlaps with the computation instead of blocking
+// the default CPU stream. Each collective waits for its inputs to be ready.
+Stream to_comm_stream(StreamOrDevice s) {
+  auto stream = to_stream(s);
+  if (stream.device == Device::cpu && !std::holds_alternative<Stream>(s)) {
+    return detail::communication_stream();
+  }
+  return stream;
+}
 
-array all_sum(
+// Check that the first axis of x can be split evenly across the group.
+void check_divisible(const char* tag, const array& x, int group_size) {
+  if (x.ndim() == 0 || x.shape(0) % group_size != 0) {
+    std::ostringstream msg;
+    msg << "[" << tag << "] The first dimension of the input must be "
+        << "divisible by the group size " << group_size
+        << " but the input has shape " << x.shape() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+}
+
+array all_reduce(
     const array& x,
-    std::optional<Group> group_ /* = std::nullopt */,
-    StreamOrDevice s /* = {} */) {
+    AllReduce::ReduceType reduce_type,
+    std::optional<Group> group_,
+    StreamOrDevice s) {
   auto group = to_group(group_);
 
   if (group.size() == 1) {
@@ -32,10 +54,120 @@ array all_sum(
   return array(
       x.shape(),
       x.dtype(),
-      std::make_shared<AllReduce>(to_stream(s), group, AllReduce::Sum),
+      std::make_shared<AllReduce>(to_comm_stream(s), group, reduce_type),
       {x});
 }
 
+} // namespace
+
+array all_sum(
+    const array& x,
+    std::optional<Group> group /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  return all_reduce(x, AllReduce::Sum, group, s);
+}
+
+std::pair<array, array> all_sum_compressed(
+    const array& x_,
+    Dtype wire_type,
+    const std::optional<array>& residual /* = std::nullopt */,
+    int group_size /* = 64 */,
+    std::optional<Group> group_ /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  auto group = to_group(group_);
+
+  if (!issubdtype(x_.dtype(), floating)) {
+    std::ostringstream msg;
+    msg << "[all_sum_compressed] Only floating point arrays can be compressed "
+        << "but the input has type " << x_.dtype() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+  if (wire_type != float16 && wire_type != bfloat16 && wire_type != int8) {
+    std::ostringstream msg;
+    msg << "[all_sum_compressed] Unsupported wire type " << wire_type
+        << ", expected float16, bfloat16 or int8.";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto dtype = x_.dtype();
+  auto x = x_;
+  if (residual) {
+    if (residual->shape() != x_.shape()) {
+      std::ostringstream msg;
+      msg << "[all_sum_compressed] The residual shape " << residual->shape()
+          << " does not match the input shape " << x_.shape() << ".";
+      throw std::invalid_argument(msg.str());
+    }
+    x = astype(add(x_, *residual, s), dtype, s);
+  }
+
+  if (group.size() == 1) {
+    return {x, zeros_like(x, s)};
+  }
+
+  if (wire_type != int8) {
+    auto wire = astype(x, wire_type, s);
+    auto error = subtract(x, astype(wire, dtype, s), s);
+    return {astype(all_sum(wire, group, s), dtype, s), error};
+  }
+
+  // Pad so that every rank gets a whole number of quantization groups
+  constexpr int bits = 8;
+  int n = x.size();
+  int chunk_size = group.size() * group_size;
+  int padded_size = ((n + chunk_size - 1) / chunk_size) * chunk_size;
+  auto flat = reshape(x, {-1}, s);
+  if (padded_size > n) {
+    flat = concatenate({flat, zeros({padded_size - n}, dtype, s)}, 0, s);
+  }
+  auto blocks = reshape(flat, {padded_size / group_size, group_size}, s);
+  auto unpad = [&](const array& a) {
+    return reshape(slice(reshape(a, {-1}, s), {0}, {n}, s), x.shape(), s);
+  };
+
+  auto [w, scales, biases] = quantize(blocks, group_size, bits, s);
+  auto error = unpad(subtract(
+      blocks, dequantize(w, scales, biases, group_size, bits, s), s));
+
+  // Reduce scatter: every rank receives the blocks of its own slice from all
+  // the ranks and sums them
+  w = all_to_all(w, group, s);
+  scales = all_to_all(scales, group, s);
+  biases = all_to_all(biases, group, s);
+  auto reduced = sum(
+      reshape(
+          dequantize(w, scales, biases, group_size, bits, s),
+          {group.size(), -1},
+          s),
+      0,
+      false,
+      s);
+
+  // All gather the quantized sums
+  std::tie(w, scales, biases) = quantize(
+      reshape(reduced, {-1, group_size}, s), group_size, bits, s);
+  w = all_gather(w, group, s);
+  scales = all_gather(scales, group, s);
+  biases = all_gather(biases, group, s);
+  auto out = unpad(dequantize(w, scales, biases, group_size, bits, s));
+
+  return {out, error};
+}
+
+array all_max(
+    const array& x,
+    std::optional<Group> group /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  return all_reduce(x, AllReduce::Max, group, s);
+}
+
+array all_min(
+    const array& x,
+    std::optional<Group> group /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  return all_reduce(x, AllReduce::Min, group, s);
+}
+
 array all_gather(
     const array& x,
     std::optional<Group> group_ /* = std::nullopt */,
@@ -55,7 +187,69 @@ array all_gather(
   return array(
       std::move(result_shape),
       x.dtype(),
-      std::make_shared<AllGather>(to_stream(s), group),
+      std::make_shared<AllGather>(to_comm_stream(s), group),
+      {x});
+}
+
+array reduce_scatter(
+    const array& x,
+    std::optional<Group> group_ /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  auto group = to_group(group_);
+
+  if (group.size() == 1) {
+    return x;
+  }
+
+  check_divisible("reduce_scatter", x, group.size());
+  auto result_shape = x.shape();
+  result_shape[0] /= group.size();
+  return array(
+      std::move(result_shape),
+      x.dtype(),
+      std::make_shared<ReduceScatter>(to_comm_stream(s), group),
+      {x});
+}
+
+array broadcast(
+    const array& x,
+    int root,
+    std::optional<Group> group_ /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  auto group = to_group(group_);
+
+  if (root < 0 || root >= group.size()) {
+    std::ostringstream msg;
+    msg << "Invalid root=" << root << " for a group of size " << group.size();
+    throw std::invalid_argument(msg.str());
+  }
+
+  if (group.size() == 1) {
+    return x;
+  }
+
+  return array(
+      x.shape(),
+      x.dtype(),
+      std::make_shared<Broadcast>(to_comm_stream(s), group, root),
+      {x});
+}
+
+array all_to_all(
+    const array& x,
+    std::optional<Group> group_ /* = std::nullopt */,
+    StreamOrDevice s /* = {} */) {
+  auto group = to_group(group_);
+
+  if (group.size() == 1) {
+    return x;
+  }
+
+  check_divisible("all_to_all", x, group.size());
+  return array(
+      x.shape(),
+      x.dtype(),
+      std::make_shared<AllToAll>(to_comm_stream(s), group),
       {x});
 }
 
@@ -78,7 +272,7 @@ array send(
   }
 
   return array(
-      {0}, int32, std::make_shared<Send>(to_stream(s), group, dst), {x});
+      {0}, int32, std::make_shared<Send>(to_comm_stream(s), group, dst), {x});
 }
 
 array recv(
@@ -102,7 +296,7 @@ array recv(
   return array(
       std::move(shape),
       std::move(dtype),
-      std::make_shared<Recv>(to_stream(s), group, src),
+      std::make_shared<Recv>(to_comm_stream(s), group, src),
       std::vector<array>{});
 }
 
@@ -14,11 +14,65 @@ array all_sum(
     std::optional<Group> group = std::nullopt,
     StreamOrDevice s = {});
 
+/**
+ * Sum x across the group sending it in the smaller wire_type format.
+ *
+ * float16 and bfloat16 cast x before the sum. int8 quantizes x in blocks of
+ * group_size elements with a scale and bias per block, exchanges the blocks
+ * so that each rank sums its own slice, and gathers the quantized sums.
+ *
+ * Returns the sum and the error made when compressing x. Passing the error as
+ * the residual of the next call for the same tensor adds it back so that the
+ * compression errors do not accumulate (error feedback).
+ */
+std::pair<array, array> all_sum_compressed(
+    const array& x,
+    Dtype wire_type,
+    const std::optional<array>& residual = std::nullopt,
+    int group_size = 64,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+array all_max(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+array all_min(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
 array all_gather(
     const array& x,
     std::optional<Group> group = std::nullopt,
     StreamOrDevice S = {});
 
+/**
+ * Sum x across the group and return the slice of the first axis that belongs
+ * to this rank. The first axis must be divisible by the group size.
+ */
+array reduce_scatter(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+/** Return the x of the root rank on every rank of the group. */
+array broadcast(
+    const array& x,
+    int root,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
+/**
+ * Split the first axis of x in one slice per rank, send the i-th slice to
+ * rank i and concatenate the received slices in rank order.
+ */
+array all_to_all(
+    const array& x,
+    std::optional<Group> group = std::nullopt,
+    StreamOrDevice s = {});
+
 array send(
     const array& x,
     int dst,
@@ -9,6 +9,20 @@
 
 namespace mlx::core::distributed {
 
+namespace {
+
+// Move the batch axis after the first axis of the unbatched input since that
+// is the axis split across the group.
+std::pair<array, int>
+batch_after_first_axis(const array& x, int ax, const Stream& s) {
+  if (ax == 0) {
+    return {moveaxis(x, 0, 1, s), 1};
+  }
+  return {x, ax};
+}
+
+} // namespace
+
 void AllReduce::eval_cpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
@@ -25,8 +39,15 @@ void AllReduce::eval_cpu(
     case Sum:
       distributed::detail::all_sum(group(), inputs[0], outputs[0]);
       break;
+    case Max:
+      distributed::detail::all_max(group(), inputs[0], outputs[0]);
+      break;
+    case Min:
+      distributed::detail::all_min(group(), inputs[0], outputs[0]);
+      break;
     default:
-      throw std::runtime_error("Only all reduce sum is supported for now");
+      throw std::runtime_error(
+          "Only all reduce sum, max and min are supported for now");
   }
 }
 
@@ -36,8 +57,13 @@ std::pair<std::vector<array>, std::vector<int>> AllReduce::vmap(
   switch (reduce_type_) {
     case Sum:
       return {{all_sum(inputs[0], group(), stream())}, axes};
+    case Max:
+      return {{all_max(inputs[0], group(), stream())}, axes};
+    case Min:
+      return {{all_min(inputs[0], group(), stream())}, axes};
     default:
-      throw std::runtime_error("Only all reduce sum is supported for now");
+      throw std::runtime_error(
+          "Only all reduce sum, max and min are supported for now");
   }
 }
 
@@ -48,8 +74,22 @@ std::vector<array> AllReduce::jvp(
   switch (reduce_type_) {
     case Sum:
       return {all_sum(tangents[0], group(), stream())};
+    case Max:
+    case Min: {
+      // The tangent of the ranks holding the extremum, averaged over ties
+      auto& x = primals[0];
+      auto& t = tangents[0];
+      auto out = (reduce_type_ == Max) ? all_max(x, group(), stream())
+                                       : all_min(x, group(), stream());
+      auto mask = astype(equal(x, out, stream()), t.dtype(), stream());
+      return {divide(
+          all_sum(multiply(t, mask, stream()), group(), stream()),
+          all_sum(mask, group(), stream()),
+          stream())};
+    }
     default:
-      throw std::runtime_error("Only all reduce sum is supported for now");
+      throw std::runtime_error(
+          "Only all reduce sum, max and min are supported for now");
   }
 }
 
@@ -58,7 +98,20 @@ std::vector<array> AllReduce::vjp(
     const std::vector<array>& cotangents,
     const std::vector<int>& argnums,
     const std::vector<array>& outputs) {
-  return cotangents;
+  switch (reduce_type_) {
+    case Max:
+    case Min: {
+      // Only the ranks holding the extremum get the cotangent, split evenly
+      // between ties like the Max and Min reductions do.
+      auto& cotan = cotangents[0];
+      auto mask = astype(
+          equal(primals[0], outputs[0], stream()), cotan.dtype(), stream());
+      auto normalizer = all_sum(mask, group(), stream());
+      return {multiply(divide(cotan, normalizer, stream()), mask, stream())};
+    }
+    default:
+      return cotangents;
+  }
 }
 
 void AllGather::eval_cpu(
@@ -98,6 +151,118 @@ std::vector<array> AllGather::vjp(
   return {slice(cotangents[0], starts, stops)};
 }
 
+void ReduceScatter::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+
+  outputs[0].set_data(allocator::malloc_or_wait(outputs[0].nbytes()));
+
+  distributed::detail::reduce_scatter(group(), inputs[0], outputs[0]);
+}
+
+std::pair<std::vector<array>, std::vector<int>> ReduceScatter::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  auto [x, ax] = batch_after_first_axis(inputs[0], axes[0], stream());
+  return {{reduce_scatter(x, group(), stream())}, {ax}};
+}
+
+std::vector<array> ReduceScatter::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  return {reduce_scatter(tangents[0], group(), stream())};
+}
+
+std::vector<array> ReduceScatter::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>& outputs) {
+  // Every rank contributed to the slice owned by every other rank
+  return {all_gather(cotangents[0], group(), stream())};
+}
+
+void Broadcast::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+
+  if (inputs[0].is_donatable()) {
+    outputs[0].copy_shared_buffer(inputs[0]);
+  } else {
+    outputs[0].set_data(allocator::malloc_or_wait(outputs[0].nbytes()));
+  }
+
+  distributed::detail::broadcast(group(), inputs[0], outputs[0], root_);
+}
+
+std::pair<std::vector<array>, std::vector<int>> Broadcast::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  return {{broadcast(inputs[0], root_, group(), stream())}, axes};
+}
+
+std::vector<array> Broadcast::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  return {broadcast(tangents[0], root_, group(), stream())};
+}
+
+std::vector<array> Broadcast::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>& outputs) {
+  // Only the root contributes to the outputs. Every rank still has to take
+  // part in the sum so the other ranks scale it by zero instead of dropping
+  // it.
+  auto g = group();
+  auto cotan = all_sum(cotangents[0], g, stream());
+  if (g.rank() == root_) {
+    return {cotan};
+  }
+  return {multiply(cotan, array(0, cotan.dtype()), stream())};
+}
+
+void AllToAll::eval_cpu(
+    const std::vector<array>& inputs,
+    std::vector<array>& outputs) {
+  assert(inputs.size() == 1);
+  assert(outputs.size() == 1);
+
+  outputs[0].set_data(allocator::malloc_or_wait(outputs[0].nbytes()));
+
+  distributed::detail::all_to_all(group(), inputs[0], outputs[0]);
+}
+
+std::pair<std::vector<array>, std::vector<int>> AllToAll::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  auto [x, ax] = batch_after_first_axis(inputs[0], axes[0], stream());
+  return {{all_to_all(x, group(), stream())}, {ax}};
+}
+
+std::vector<array> AllToAll::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  return {all_to_all(tangents[0], group(), stream())};
+}
+
+std::vector<array> AllToAll::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>& outputs) {
+  // The exchange is its own transpose
+  return {all_to_all(cotangents[0], group(), stream())};
+}
+
 void Send::eval_cpu(
     const std::vector<array>& inputs,
     std::vector<array>& outputs) {
@@ -0,0 +1,657 @@
+// Copyright © 2024 Apple Inc.
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "mlx/backend/common/copy.h"
+#include "mlx/distributed/ring/ring.h"
+
+namespace mlx::core::distributed::ring {
+
+namespace {
+
+// A peer may start listening a bit after we try to reach it so retry for
+// roughly 10 seconds before giving up.
+constexpr int connect_retries = 1000;
+constexpr auto connect_retry_wait = std::chrono::milliseconds(10);
+
+// Broadcasts are forwarded in blocks of this many bytes.
+constexpr size_t broadcast_block_size = 1 << 20;
+
+#ifdef MSG_NOSIGNAL
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+
+array ensure_row_contiguous(const array& arr) {
+  if (arr.flags().row_contiguous) {
+    return arr;
+  } else {
+    array arr_copy(arr.shape(), arr.dtype(), nullptr, {});
+    copy(arr, arr_copy, CopyType::General);
+    return arr_copy;
+  }
+}
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  std::ostringstream msg;
+  msg << "[ring] " << what << ": " << std::strerror(errno);
+  throw std::runtime_error(msg.str());
+}
+
+// Owns a socket file descriptor and closes it on destruction.
+class Socket {
+ public:
+  Socket() = default;
+  explicit Socket(int fd) : fd_(fd) {}
+  Socket(const Socket&) = delete;
+  Socket& operator=(const Socket&) = delete;
+  Socket(Socket&& other) : fd_(other.fd_) {
+    other.fd_ = -1;
+  }
+  Socket& operator=(Socket&& other) {
+    if (this != &other) {
+      reset();
+      fd_ = other.fd_;
+      other.fd_ = -1;
+    }
+    return *this;
+  }
+  ~Socket() {
+    reset();
+  }
+
+  int fd() const {
+    return fd_;
+  }
+
+ private:
+  void reset() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  int fd_{-1};
+};
+
+struct Address {
+  sockaddr_storage addr;
+  socklen_t len;
+  std::string name;
+};
+
+Address parse_address(const std::string& name) {
+  auto colon = name.rfind(':');
+  if (colon == std::string::npos || colon == 0 || colon + 1 == name.size()) {
+    std::ostringstream msg;
+    msg << "[ring] Invalid address '" << name
+        << "', expected an address of the form host:port.";
+    throw std::invalid_argument(msg.str());
+  }
+  auto host = name.substr(0, colon);
+  auto port = name.substr(colon + 1);
+
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  addrinfo* info;
+  if (int err = getaddrinfo(host.c_str(), port.c_str(), &hints, &info);
+      err != 0) {
+    std::ostringstream msg;
+    msg << "[ring] Could not resolve '" << name << "': " << gai_strerror(err);
+    throw std::runtime_error(msg.str());
+  }
+
+  Address address;
+  std::memcpy(&address.addr, info->ai_addr, info->ai_addrlen);
+  address.len = info->ai_addrlen;
+  address.name = name;
+  freeaddrinfo(info);
+  return address;
+}
+
+void configure_socket(const Socket& s) {
+  int one = 1;
+  setsockopt(s.fd(), IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+  setsockopt(s.fd(), SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+}
+
+Socket listen_on(const Address& address) {
+  Socket s(::socket(address.addr.ss_family, SOCK_STREAM, 0));
+  if (s.fd() < 0) {
+    throw_errno("Could not create socket");
+  }
+  int one = 1;
+  setsockopt(s.fd(), SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (::bind(s.fd(), (const sockaddr*)&address.addr, address.len) < 0) {
+    throw_errno("Could not bind to " + address.name);
+  }
+  if (::listen(s.fd(), 1) < 0) {
+    throw_errno("Could not listen on " + address.name);
+  }
+  return s;
+}
+
+Socket connect_to(const Address& address) {
+  for (int attempt = 1;; attempt++) {
+    Socket s(::socket(address.addr.ss_family, SOCK_STREAM, 0));
+    if (s.fd() < 0) {
+      throw_errno("Could not create socket");
+    }
+    if (::connect(s.fd(), (const sockaddr*)&address.addr, address.len) == 0) {
+      configure_socket(s);
+      return s;
+    }
+    if (attempt == connect_retries) {
+      throw_errno("Could not connect to " + address.name);
+    }
+    std::this_thread::sleep_for(connect_retry_wait);
+  }
+}
+
+Socket accept_from(const Socket& listener) {
+  int fd;
+  do {
+    fd = ::accept(listener.fd(), nullptr, nullptr);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    throw_errno("Could not accept a connection");
+  }
+  Socket s(fd);
+  configure_socket(s);
+  return s;
+}
+
+void send_all(const Socket& s, const char* data, size_t n) {
+  while (n > 0) {
+    auto sent = ::send(s.fd(), data, n, send_flags);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_errno("Send failed");
+    }
+    data += sent;
+    n -= sent;
+  }
+}
+
+void recv_all(const Socket& s, char* data, size_t n) {
+  while (n > 0) {
+    auto received = ::recv(s.fd(), data, n, 0);
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_errno("Receive failed");
+    }
+    if (received == 0) {
+      throw std::runtime_error("[ring] Connection closed by peer.");
+    }
+    data += received;
+    n -= received;
+  }
+}
+
+// Send to one socket while receiving from another. Both transfers make
+// progress together so that every rank in the ring can send and receive at
+// the same time without deadlocking on full socket buffers.
+void send_recv(
+    const Socket& out,
+    const char* send_data,
+    size_t send_n,
+    const Socket& in,
+    char* recv_data,
+    size_t recv_n) {
+  while (send_n > 0 || recv_n > 0) {
+    pollfd fds[2];
+    int nfds = 0;
+    int send_idx = -1;
+    int recv_idx = -1;
+    if (send_n > 0) {
+      send_idx = nfds;
+      fds[nfds++] = {out.fd(), POLLOUT, 0};
+    }
+    if (recv_n > 0) {
+      recv_idx = nfds;
+      fds[nfds++] = {in.fd(), POLLIN, 0};
+    }
+    if (::poll(fds, nfds, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_errno("Poll failed");
+    }
+
+    if (send_idx >= 0 && fds[send_idx].revents != 0) {
+      auto sent =
+          ::send(out.fd(), send_data, send_n, send_flags | MSG_DONTWAIT);
+      if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+          throw_errno("Send failed");
+        }
+      } else {
+        send_data += sent;
+        send_n -= sent;
+      }
+    }
+    if (recv_idx >= 0 && fds[recv_idx].revents != 0) {
+      auto received = ::recv(in.fd(), recv_data, recv_n, MSG_DONTWAIT);
+      if (received < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+          throw_errno("Receive failed");
+        }
+      } else if (received == 0) {
+        throw std::runtime_error("[ring] Connection closed by peer.");
+      } else {
+        recv_data += received;
+        recv_n -= received;
+      }
+    }
+  }
+}
+
+struct SumOp {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return a + b;
+  }
+};
+
+struct MaxOp {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return (b > a) ? b : a;
+  }
+};
+
+struct MinOp {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return (b < a) ? b : a;
+  }
+};
+
+template <typename T, typename Op>
+void reduce_elements(const char* in_, char* out_, size_t n, Op op) {
+  auto in = reinterpret_cast<const T*>(in_);
+  auto out = reinterpret_cast<T*>(out_);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = op(out[i], in[i]);
+  }
+}
+
+// Reduce n elements of in into out.
+using ReduceFn = void (*)(const char* in, char* out, size_t n, Dtype dtype);
+
+template <typename Op>
+void reduce_inplace(const char* in, char* out, size_t n, Dtype dtype) {
+  switch (dtype) {
+    case bool_:
+      return reduce_elements<bool>(in, out, n, Op{});
+    case uint8:
+      return reduce_elements<uint8_t>(in, out, n, Op{});
+    case uint16:
+      return reduce_elements<uint16_t>(in, out, n, Op{});
+    case uint32:
+      return reduce_elements<uint32_t>(in, out, n, Op{});
+    case uint64:
+      return reduce_elements<uint64_t>(in, out, n, Op{});
+    case int8:
+      return reduce_elements<int8_t>(in, out, n, Op{});
+    case int16:
+      return reduce_elements<int16_t>(in, out, n, Op{});
+    case int32:
+      return reduce_elements<int32_t>(in, out, n, Op{});
+    case int64:
+      return reduce_elements<int64_t>(in, out, n, Op{});
+    case float16:
+      return reduce_elements<float16_t>(in, out, n, Op{});
+    case float32:
+      return reduce_elements<float>(in, out, n, Op{});
+    case bfloat16:
+      return reduce_elements<bfloat16_t>(in, out, n, Op{});
+    case complex64:
+      return reduce_elements<complex64_t>(in, out, n, Op{});
+  }
+}
+
+std::vector<std::string> read_hosts() {
+  std::vector<std::string> hosts;
+  auto add_host = [&hosts](std::string host) {
+    auto begin = host.find_first_not_of(" \t\r");
+    if (begin == std::string::npos || host[begin] == '#') {
+      return;
+    }
+    auto end = host.find_last_not_of(" \t\r");
+    hosts.push_back(host.substr(begin, end - begin + 1));
+  };
+
+  if (const char* list = std::getenv("MLX_HOSTS")) {
+    std::istringstream stream(list);
+    std::string host;
+    while (std::getline(stream, host, ',')) {
+      add_host(host);
+    }
+  } else if (const char* path = std::getenv("MLX_HOSTFILE")) {
+    std::ifstream file(path);
+    if (!file) {
+      std::ostringstream msg;
+      msg << "[ring] Could not open the hostfile '" << path << "'.";
+      throw std::runtime_error(msg.str());
+    }
+    std::string host;
+    while (std::getline(file, host)) {
+      add_host(host);
+    }
+  }
+  return hosts;
+}
+
+class RingGroup : public GroupImpl {
+ public:
+  RingGroup(int rank, const std::vector<std::string>& hosts)
+      : rank_(rank), size_(hosts.size()) {
+    if (size_ == 1) {
+      return;
+    }
+
+    // Every rank listens first and then connects to its right neighbor. The
+    // connection completes as soon as the neighbor listens so accepting the
+    // left neighbor afterwards cannot deadlock.
+    auto listener = listen_on(parse_address(hosts[rank_]));
+    right_ = connect_to(parse_address(hosts[next()]));
+    int32_t self = rank_;
+    send_all(right_, reinterpret_cast<const char*>(&self), sizeof(self));
+    left_ = accept_from(listener);
+    int32_t peer;
+    recv_all(left_, reinterpret_cast<char*>(&peer), sizeof(peer));
+    if (peer != prev()) {
+      std::ostringstream msg;
+      msg << "[ring] Rank " << rank_ << " expected a connection from rank "
+          << prev() << " but got one from rank " << peer << ".";
+      throw std::runtime_error(msg.str());
+    }
+  }
+
+  int rank() override {
+    return rank_;
+  }
+
+  int size() override {
+    return size_;
+  }
+
+  std::shared_ptr<GroupImpl> split(int color, int key = -1) override {
+    throw std::runtime_error("[ring] Group split is not supported.");
+  }
+
+  void all_sum(const array& input, array& output) override {
+    all_reduce(input, output, &reduce_inplace<SumOp>);
+  }
+
+  void all_max(const array& input, array& output) override {
+    all_reduce(input, output, &reduce_inplace<MaxOp>);
+  }
+
+  void all_min(const array& input, array& output) override {
+    all_reduce(input, output, &reduce_inplace<MinOp>);
+  }
+
+  void all_gather(const array& input_, array& output) override {
+    array input = ensure_row_contiguous(input_);
+    size_t nbytes = input.nbytes();
+    char* data = output.data<char>();
+    std::memcpy(data + rank_ * nbytes, input.data<char>(), nbytes);
+    ring_all_gather(data, output.size(), output.itemsize());
+  }
+
+  void reduce_scatter(const array& input_, array& output) override {
+    array input = ensure_row_contiguous(input_);
+
+    // Reduce in a scratch buffer so that the input is left untouched and
+    // keep the chunk this rank ends up owning.
+    std::vector<char> scratch(input.nbytes());
+    std::memcpy(scratch.data(), input.data<char>(), input.nbytes());
+    ring_reduce_scatter(
+        scratch.data(),
+        input.size(),
+        input.itemsize(),
+        input.dtype(),
+        &reduce_inplace<SumOp>);
+    auto [begin, end] = chunk(input.size(), rank_);
+    std::memcpy(
+        output.data<char>(),
+        scratch.data() + begin * input.itemsize(),
+        (end - begin) * input.itemsize());
+  }
+
+  void broadcast(const array& input_, array& output, int root) override {
+    array input = ensure_row_contiguous(input_);
+    char* data = output.data<char>();
+    if (rank_ == root && input.data<void>() != output.data<void>()) {
+      std::memcpy(data, input.data<char>(), input.nbytes());
+    }
+    if (size_ == 1) {
+      return;
+    }
+
+    // Pass the data around the ring starting from the root. It is split in
+    // blocks so that a rank forwards a block while receiving the next one and
+    // all the links are busy at the same time.
+    size_t nbytes = output.nbytes();
+    size_t n_blocks =
+        (nbytes + broadcast_block_size - 1) / broadcast_block_size;
+    bool receive = rank_ != root;
+    bool forward = next() != root;
+    auto block_bytes = [&](size_t b) {
+      return std::min(broadcast_block_size, nbytes - b * broadcast_block_size);
+    };
+    for (size_t b = 0; b <= n_blocks; b++) {
+      size_t send_block = (b > 0) ? b - 1 : 0;
+      send_recv(
+          right_,
+          data + send_block * broadcast_block_size,
+          (forward && b > 0) ? block_bytes(send_block) : 0,
+          left_,
+          data + b * broadcast_block_size,
+          (receive && b < n_blocks) ? block_bytes(b) : 0);
+    }
+  }
+
+  void all_to_all(const array& input_, array& output) override {
+    array input = ensure_row_contiguous(input_);
+    size_t block = input.nbytes() / size_;
+    const char* in = input.data<char>();
+    char* out = output.data<char>();
+    std::memcpy(out + rank_ * block, in + rank_ * block, block);
+    if (size_ == 1) {
+      return;
+    }
+
+    // Only neighbors are connected so the block from rank r to rank r + d
+    // travels d hops to the right. At step t every rank sends the size - t
+    // blocks that still need to travel, ordered by distance, and keeps the
+    // first one it receives since it is addressed to it.
+    std::vector<char> to_send((size_ - 1) * block);
+    std::vector<char> received((size_ - 1) * block);
+    for (int d = 1; d < size_; d++) {
+      std::memcpy(
+          to_send.data() + (d - 1) * block,
+          in + ((rank_ + d) % size_) * block,
+          block);
+    }
+    size_t offset = 0;
+    for (int t = 1; t < size_; t++) {
+      size_t n = (size_ - t) * block;
+      send_recv(
+          right_, to_send.data() + offset, n, left_, received.data(), n);
+      int src = (rank_ - t + size_) % size_;
+      std::memcpy(out + src * block, received.data(), block);
+      std::swap(to_send, received);
+      offset = block;
+    }
+  }
+
+  void send(const array& input_, int dst) override {
+    array input = ensure_row_contiguous(input_);
+    send_all(neighbor(dst, right_, left_), input.data<char>(), input.nbytes());
+  }
+
+  void recv(array& out, int src) override {
+    recv_all(neighbor(src, left_, right_), out.data<char>(), out.nbytes());
+  }
+
+ private:
+  // Split n elements in one chunk per rank and return the range of chunk c.
+  std::pair<size_t, size_t> chunk(size_t n, int c) const {
+    c = (c % size_ + size_) % size_;
+    return {n * c / size_, n * (c + 1) / size_};
+  }
+
+  // After the reduce scatter each rank holds the reduction of its own chunk.
+  // At step s the chunk received from the left holds the reduction of s + 2
+  // ranks.
+  void ring_reduce_scatter(
+      char* data,
+      size_t n,
+      size_t itemsize,
+      Dtype dtype,
+      ReduceFn reduce) {
+    std::vector<char> buffer(((n + size_ - 1) / size_) * itemsize);
+    for (int s = 0; s < size_ - 1; s++) {
+      auto [send_begin, send_end] = chunk(n, rank_ - s - 1);
+      auto [recv_begin, recv_end] = chunk(n, rank_ - s - 2);
+      send_recv(
+          right_,
+          data + send_begin * itemsize,
+          (send_end - send_begin) * itemsize,
+          left_,
+          buffer.data(),
+          (recv_end - recv_begin) * itemsize);
+      reduce(
+          buffer.data(),
+          data + recv_begin * itemsize,
+          recv_end - recv_begin,
+          dtype);
+    }
+  }
+
+  // Starting from each rank holding its own chunk, pass the chunks around the
+  // ring until every rank has all of them.
+  void ring_all_gather(char* data, size_t n, size_t itemsize) {
+    for (int s = 0; s < size_ - 1; s++) {
+      auto [send_begin, send_end] = chunk(n, rank_ - s);
+      auto [recv_begin, recv_end] = chunk(n, rank_ - s - 1);
+      send_recv(
+          right_,
+          data + send_begin * itemsize,
+          (send_end - send_begin) * itemsize,
+          left_,
+          data + recv_begin * itemsize,
+          (recv_end - recv_begin) * itemsize);
+    }
+  }
+
+  void all_reduce(const array& input_, array& output, ReduceFn reduce) {
+    array input = ensure_row_contiguous(input_);
+    if (input.data<void>() != output.data<void>()) {
+      std::memcpy(output.data<char>(), input.data<char>(), input.nbytes());
+    }
+    if (size_ == 1) {
+      return;
+    }
+    char* data = output.data<char>();
+    ring_reduce_scatter(
+        data, output.size(), output.itemsize(), output.dtype(), reduce);
+    ring_all_gather(data, output.size(), output.itemsize());
+  }
+
+  int next() const {
+    return (rank_ + 1) % size_;
+  }
+
+  int prev() const {
+    return (rank_ + size_ - 1) % size_;
+  }
+
+  // Pick the connection to use to talk to a neighbor. For a group of two the
+  // next and previous ranks coincide so the preferred socket is tried first.
+  const Socket& neighbor(int peer, const Socket& first, const Socket& second) {
+    int first_peer = (&first == &right_) ? next() : prev();
+    int second_peer = (&second == &right_) ? next() : prev();
+    if (size_ > 1 && peer == first_peer) {
+      return first;
+    }
+    if (size_ > 1 && peer == second_peer) {
+      return second;
+    }
+    std::ostringstream msg;
+    msg << "[ring] Rank " << rank_
+        << " can only send to and receive from its neighbors in the ring but "
+        << "rank " << peer << " was requested.";
+    throw std::invalid_argument(msg.str());
+  }
+
+  int rank_;
+  int size_;
+  Socket left_;
+  Socket right_;
+};
+
+} // namespace
+
+bool is_available() {
+  return true;
+}
+
+std::shared_ptr<GroupImpl> init(bool strict /* = false */) {
+  static std::shared_ptr<RingGroup> global_group = nullptr;
+
+  if (global_group == nullptr) {
+    auto hosts = read_hosts();
+    const char* rank_str = std::getenv("MLX_RANK");
+    if (hosts.empty() || rank_str == nullptr) {
+      if (strict) {
+        throw std::runtime_error(
+            "[ring] MLX_RANK and one of MLX_HOSTFILE or MLX_HOSTS must be "
+            "set.");
+      }
+      return nullptr;
+    }
+
+    int rank = std::atoi(rank_str);
+    if (rank < 0 || rank >= static_cast<int>(hosts.size())) {
+      std::ostringstream msg;
+      msg << "[ring] Invalid rank " << rank_str << " for " << hosts.size()
+          << " hosts.";
+      throw std::invalid_argument(msg.str());
+    }
+    global_group = std::make_shared<RingGroup>(rank, hosts);
+  }
+
+  return global_group;
+}
+
+} // namespace mlx::core::distributed::ring
@@ -268,6 +268,7 @@ struct PrimitiveFactory {
       SERIALIZE_PRIMITIVE(Floor),
       SERIALIZE_PRIMITIVE(Full),
       SERIALIZE_PRIMITIVE(Gather),
+      SERIALIZE_PRIMITIVE(GatherAxis),
       SERIALIZE_PRIMITIVE(GatherMM),
       SERIALIZE_PRIMITIVE(Greater),
       SERIALIZE_PRIMITIVE(GreaterEqual),
@@ -319,6 +320,7 @@ struct PrimitiveFactory {
       SERIALIZE_PRIMITIVE(Subtract),
       SERIALIZE_PRIMITIVE(Tan),
       SERIALIZE_PRIMITIVE(Tanh),
+      SERIALIZE_PRIMITIVE(TopK),
       SERIALIZE_PRIMITIVE(View),
       SERIALIZE_PRIMITIVE(Transpose),
       SERIALIZE_PRIMITIVE(Unflatten),
@@ -98,14 +98,11 @@ array rms_norm(
     x = astype(x, out_type, s);
     return std::vector<array>{multiply(inputs[1], x, s)};
   };
-  if (s.device == Device::gpu) {
-    return array(
-        x.shape(),
-        out_type,
-        std::make_shared<RMSNorm>(s, fallback, eps),
-        {astype(x, out_type, s), astype(weight, out_type, s)});
-  }
-  return fallback({x, weight})[0];
+  return array(
+      x.shape(),
+      out_type,
+      std::make_shared<RMSNorm>(s, fallback, eps),
+      {astype(x, out_type, s), astype(weight, out_type, s)});
 }
 
 std::vector<array> RMSNorm::vjp(
@@ -238,14 +235,11 @@ array layer_norm(
   auto passed_bias =
       astype((bias.has_value()) ? *bias : array(0, out_type), out_type);
 
-  if (s.device == Device::gpu) {
-    return array(
-        x.shape(),
-        out_type,
-        std::make_shared<LayerNorm>(s, fallback, eps),
-        {astype(x, out_type, s), passed_weight, passed_bias});
-  }
-  return fallback({x, passed_weight, passed_bias})[0];
+  return array(
+      x.shape(),
+      out_type,
+      std::make_shared<LayerNorm>(s, fallback, eps),
+      {astype(x, out_type, s), passed_weight, passed_bias});
 }
 
 std::vector<array> LayerNorm::vjp(
@@ -447,7 +441,7 @@ array rope(
     }
   };
   auto stream = to_stream(s);
-  if (stream.device == Device::gpu) {
+  if (stream.device == Device::gpu || issubdtype(x.dtype(), floating)) {
     return array(
         x.shape(),
         x.dtype(),
@@ -621,8 +615,8 @@ array scaled_dot_product_attention(
   auto v = astype(values, final_type, s);
 
   /* generic implementation for use cases that Metal implementation does not
-   * support. For non-supported cases listed below, use MLX primitives:
-   * * CPU implementation
+   * support. The CPU implementation supports every case for fp32, fp16 and
+   * bf16. On the GPU, use MLX primitives for the non-supported cases below:
    * * batch size > 1 for decoding or causal attention
    * * query sequence length > 1 for decoding
    * * query sequence length > 16 && non-null mask (causal attention)
@@ -689,16 +683,30 @@ array scaled_dot_product_attention(
       !mask.has_value() && sdpa_vector_supported_head_dim &&
       stream.device == Device::gpu;
 
+  const bool supports_sdpa_cpu = stream.device == Device::cpu &&
+      (final_type == float32 || final_type == float16 ||
+       final_type == bfloat16);
+
   implementation_supports_use_case &=
       supports_sdpa_full || supports_sdpa_vector;
+  implementation_supports_use_case |= supports_sdpa_cpu;
 
   if (implementation_supports_use_case) {
     auto out_shape = Shape{q.shape(0), q.shape(1), q.shape(2), v.shape(-1)};
+    std::vector<array> inputs = {q, k, v};
+    if (mask.has_value()) {
+      // Only the CPU implementation takes a mask which it reads in place
+      // through the strides of the broadcast
+      inputs.push_back(broadcast_to(
+          astype(mask.value(), final_type, s),
+          {q.shape(0), q.shape(1), q.shape(2), k.shape(2)},
+          s));
+    }
     return array(
         std::move(out_shape),
         final_type,
         std::make_shared<ScaledDotProductAttention>(stream, fallback, scale),
-        {q, k, v});
+        std::move(inputs));
   }
 
   if (mask.has_value()) {
@@ -11,6 +11,8 @@
 #define NOMINMAX
 #endif
 #include <windows.h>
+#else
+#include <sys/mman.h>
 #endif // _WIN32
 
 #include "mlx/io/load.h"
@@ -379,6 +381,36 @@ void ParallelFileReader::read(char* data, size_t n, size_t offset) {
   }
 }
 
+MappedFileReader::Region
+MappedFileReader::map(size_t offset, size_t n, size_t prefix /* = 0 */) {
+#ifdef _WIN32
+  return {};
+#else
+  struct stat st;
+  if (n == 0 || offset < prefix || fstat(fd_, &st) != 0 ||
+      offset + n > static_cast<size_t>(st.st_size)) {
+    return {};
+  }
+  size_t page_size = sysconf(_SC_PAGESIZE);
+  size_t start = (offset - prefix) / page_size * page_size;
+  size_t length = offset + n - start;
+  void* base =
+      mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd_, start);
+  if (base == MAP_FAILED) {
+    return {};
+  }
+  return {base, length, static_cast<char*>(base) + (offset - start)};
+#endif
+}
+
+void MappedFileReader::unmap(const Region& region) {
+#ifndef _WIN32
+  if (region.base != nullptr) {
+    munmap(region.base, region.length);
+  }
+#endif
+}
+
 } // namespace io
 
 } // namespace mlx::core
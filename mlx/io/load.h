@@ -99,11 +99,42 @@ class ParallelFileReader : public Reader {
     return "file " + label_;
   }
 
+ protected:
+  int fd_;
+  std::string label_;
+
  private:
   static constexpr size_t batch_size_ = 1 << 25;
   static ThreadPool thread_pool_;
-  int fd_;
-  std::string label_;
+};
+
+// A file reader that can also map parts of the file into memory. Arrays
+// loaded from it on the CPU are backed directly by the mapped pages so they
+// share the page cache with other processes and only take up memory once
+// they are touched. The mappings are private so writing to the arrays, e.g.
+// when their memory is donated, copies the affected pages and never modifies
+// the file.
+class MappedFileReader : public ParallelFileReader {
+ public:
+  struct Region {
+    void* base{nullptr};
+    size_t length{0};
+    char* data{nullptr};
+  };
+
+  explicit MappedFileReader(std::string file_path)
+      : ParallelFileReader(std::move(file_path)) {}
+
+  // Map the n bytes at offset such that at least prefix bytes before them
+  // are mapped as well. Returns an empty region if the bytes are not in the
+  // file or the platform does not support memory mapping.
+  Region map(size_t offset, size_t n, size_t prefix = 0);
+
+  static void unmap(const Region& region);
+
+  std::string label() const override {
+    return "mapped file " + label_;
+  }
 };
 
 class FileWriter : public Writer {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "mlx/array.h"
+#include "mlx/backend/common/threading.h"
 #include "mlx/backend/metal/metal.h"
 #include "mlx/compile.h"
 #include "mlx/device.h"
@@ -15,6 +16,7 @@
 #include "mlx/io.h"
 #include "mlx/linalg.h"
 #include "mlx/ops.h"
+#include "mlx/profiler.h"
 #include "mlx/random.h"
 #include "mlx/stream.h"
 #include "mlx/transforms.h"
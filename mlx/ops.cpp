@@ -2106,28 +2106,46 @@ array topk(const array& a, int k, StreamOrDevice s /* = {}*/) {
   return topk(reshape(a, {size}, s), k, 0, s);
 }
 
-/** Returns topk elements of the array along a given axis. */
-array topk(const array& a, int k, int axis, StreamOrDevice s /* = {}*/) {
+namespace {
+
+int check_topk_args(
+    const std::string& tag,
+    const array& a,
+    int k,
+    int axis) {
   // Check for valid axis
   int axis_ = axis < 0 ? axis + a.ndim() : axis;
   if (axis_ < 0 || axis_ >= static_cast<int>(a.ndim())) {
     std::ostringstream msg;
-    msg << "[topk] Received invalid axis " << axis << " for array with "
+    msg << tag << " Received invalid axis " << axis << " for array with "
         << a.ndim() << " dimensions.";
     throw std::invalid_argument(msg.str());
   }
   if (k < 0 || k > a.shape(axis_)) {
     std::ostringstream msg;
-    msg << "[topk] Received invalid k=" << k << " along axis " << axis
+    msg << tag << " Received invalid k=" << k << " along axis " << axis
         << " for array with shape: " << a.shape();
     throw std::invalid_argument(msg.str());
   }
+  return axis_;
+}
+
+} // namespace
+
+/** Returns topk elements of the array along a given axis. */
+array topk(const array& a, int k, int axis, StreamOrDevice s /* = {}*/) {
+  int axis_ = check_topk_args("[topk]", a, k, axis);
 
   // Return early if the whole input was requested.
   if (k == a.shape(axis_)) {
     return a;
   }
 
+  // The CPU selects the values in one pass with the TopK primitive
+  if (to_stream(s).device == Device::cpu) {
+    return topk_with_indices(a, k, axis_, s).first;
+  }
+
   array a_partitioned = partition(a, -k, axis_, s);
   Shape slice_starts(a.ndim(), 0);
   auto slice_ends = a.shape();
@@ -2135,6 +2153,39 @@ array topk(const array& a, int k, int axis, StreamOrDevice s /* = {}*/) {
   return slice(a_partitioned, slice_starts, slice_ends, s);
 }
 
+std::pair<array, array>
+topk_with_indices(const array& a, int k, StreamOrDevice s /* = {}*/) {
+  int size = a.size();
+  return topk_with_indices(reshape(a, {size}, s), k, 0, s);
+}
+
+std::pair<array, array> topk_with_indices(
+    const array& a,
+    int k,
+    int axis,
+    StreamOrDevice s /* = {}*/) {
+  int axis_ = check_topk_args("[topk_with_indices]", a, k, axis);
+
+  auto stream = to_stream(s);
+  if (stream.device == Device::gpu) {
+    auto indices = argpartition(a, -k, axis_, s);
+    Shape slice_starts(a.ndim(), 0);
+    auto slice_ends = a.shape();
+    slice_starts[axis_] = a.shape(axis_) - k;
+    indices = slice(indices, slice_starts, slice_ends, s);
+    return {take_along_axis(a, indices, axis_, s), indices};
+  }
+
+  auto shape = a.shape();
+  shape[axis_] = k;
+  auto out = array::make_arrays(
+      {shape, shape},
+      {a.dtype(), uint32},
+      std::make_shared<TopK>(stream, k, axis_),
+      {a});
+  return {out[0], out[1]};
+}
+
 array logsumexp(const array& a, bool keepdims, StreamOrDevice s /* = {}*/) {
   std::vector<int> axes(a.ndim());
   std::iota(axes.begin(), axes.end(), 0);
@@ -2613,7 +2664,9 @@ array matmul(
   }
   // Type promotion
   auto out_type = promote_types(a.dtype(), b.dtype());
-  if (!issubdtype(out_type, floating)) {
+  // Two int8 inputs are multiplied exactly into an int32 result
+  bool int8_inputs = a.dtype() == int8 && b.dtype() == int8;
+  if (!issubdtype(out_type, floating) && !int8_inputs) {
     std::ostringstream msg;
     msg << "[matmul] Only real floating point types are supported but "
         << a.dtype() << " and " << b.dtype() << " were provided which results"
@@ -2626,6 +2679,9 @@ array matmul(
   if (b.dtype() != out_type) {
     b = astype(b, out_type, s);
   }
+  if (int8_inputs) {
+    out_type = int32;
+  }
 
   // We can batch the multiplication by reshaping a
   if (in_a.ndim() > 2 && in_b.ndim() <= 2) {
@@ -2860,6 +2916,27 @@ array take_along_axis(
   // Allow negative axis
   axis = axis < 0 ? a.ndim() + axis : axis;
 
+  // The CPU gathers along the axis directly instead of building an index
+  // array for every other dimension
+  if (to_stream(s).device == Device::cpu) {
+    if (indices.dtype() == bool_ || issubdtype(indices.dtype(), inexact)) {
+      throw std::invalid_argument(
+          "[take_along_axis] Floating point or boolean indices are not "
+          "supported.");
+    }
+    auto out_shape = a.shape();
+    out_shape[axis] = indices.shape(axis);
+    out_shape = broadcast_shapes(out_shape, indices.shape());
+    auto idx = broadcast_to(indices, out_shape, s);
+    out_shape[axis] = a.shape(axis);
+    auto src = broadcast_to(a, out_shape, s);
+    return array(
+        idx.shape(),
+        a.dtype(),
+        std::make_shared<GatherAxis>(to_stream(s), axis),
+        {src, idx});
+  }
+
   std::vector<array> nd_indices;
   Shape index_shape(a.ndim(), 1);
   for (int i = 0; i < a.ndim(); ++i) {
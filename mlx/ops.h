@@ -694,6 +694,20 @@ array topk(const array& a, int k, StreamOrDevice s = {});
 /** Returns topk elements of the array along a given axis. */
 array topk(const array& a, int k, int axis, StreamOrDevice s = {});
 
+/**
+ * Returns topk elements of the flattened array and their indices. The
+ * elements are in no particular order.
+ **/
+std::pair<array, array>
+topk_with_indices(const array& a, int k, StreamOrDevice s = {});
+
+/**
+ * Returns topk elements of the array along a given axis and their indices
+ * along that axis. The elements are in no particular order.
+ **/
+std::pair<array, array>
+topk_with_indices(const array& a, int k, int axis, StreamOrDevice s = {});
+
 /** The logsumexp of all elements of the array. */
 array logsumexp(const array& a, bool keepdims, StreamOrDevice s = {});
 inline array logsumexp(const array& a, StreamOrDevice s = {}) {
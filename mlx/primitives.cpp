@@ -2012,6 +2012,85 @@ std::vector<Shape> Gather::output_shapes(const std::vector<array>& inputs) {
   return {std::move(out_shape)};
 }
 
+std::pair<std::vector<array>, std::vector<int>> GatherAxis::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  // Move the vmapped axes to the front, take_along_axis broadcasts the one
+  // which is not vmapped
+  auto src = inputs[0];
+  auto indices = inputs[1];
+  if (axes[0] >= 0) {
+    src = moveaxis(src, axes[0], 0, stream());
+  } else {
+    src = expand_dims(src, 0, stream());
+  }
+  if (axes[1] >= 0) {
+    indices = moveaxis(indices, axes[1], 0, stream());
+  } else {
+    indices = expand_dims(indices, 0, stream());
+  }
+  return {{take_along_axis(src, indices, axis_ + 1, stream())}, {0}};
+}
+
+std::vector<array> GatherAxis::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>& argnums,
+    const std::vector<array>&) {
+  std::vector<array> vjps;
+  for (int argnum : argnums) {
+    if (argnum > 0) {
+      // Grads w.r.t. indices are zero
+      vjps.push_back(
+          zeros(primals[argnum].shape(), primals[argnum].dtype(), stream()));
+    } else {
+      // Indices may repeat so the cotangent is accumulated with scatter_add
+      auto& src = primals[0];
+      std::vector<array> nd_indices;
+      Shape index_shape(src.ndim(), 1);
+      for (int i = 0; i < src.ndim(); ++i) {
+        if (i == axis_) {
+          nd_indices.push_back(primals[1]);
+        } else {
+          index_shape[i] = src.shape(i);
+          nd_indices.push_back(
+              reshape(arange(src.shape(i), stream()), index_shape, stream()));
+          index_shape[i] = 1;
+        }
+      }
+      auto update_shape = cotangents[0].shape();
+      update_shape.resize(update_shape.size() + src.ndim(), 1);
+      auto update = reshape(cotangents[0], std::move(update_shape), stream());
+      std::vector<int> dims(src.ndim());
+      std::iota(dims.begin(), dims.end(), 0);
+      vjps.push_back(scatter_add(
+          zeros_like(src, stream()), nd_indices, update, dims, stream()));
+    }
+  }
+  return vjps;
+}
+
+std::vector<array> GatherAxis::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>& argnums) {
+  if (argnums.size() > 1 || argnums[0] != 0) {
+    throw std::invalid_argument(
+        "[take_along_axis] Cannot calculate JVP with respect to indices.");
+  }
+  return {take_along_axis(tangents[0], primals[1], axis_, stream())};
+}
+
+bool GatherAxis::is_equivalent(const Primitive& other) const {
+  const GatherAxis& g_other = static_cast<const GatherAxis&>(other);
+  return axis_ == g_other.axis_;
+}
+
+std::vector<Shape> GatherAxis::output_shapes(
+    const std::vector<array>& inputs) {
+  return {inputs[1].shape()};
+}
+
 std::pair<std::vector<array>, std::vector<int>> Greater::vmap(
     const std::vector<array>& inputs,
     const std::vector<int>& axes) {
@@ -4056,6 +4135,53 @@ std::pair<std::vector<array>, std::vector<int>> Tanh::vmap(
   return {{tanh(inputs[0], stream())}, axes};
 }
 
+std::pair<std::vector<array>, std::vector<int>> TopK::vmap(
+    const std::vector<array>& inputs,
+    const std::vector<int>& axes) {
+  assert(inputs.size() == 1);
+  assert(axes.size() == 1);
+
+  int axis_left = axes[0] >= 0 && axes[0] <= axis_;
+  auto [values, indices] =
+      topk_with_indices(inputs[0], k_, axis_ + axis_left, stream());
+  return {{values, indices}, {axes[0], axes[0]}};
+}
+
+std::vector<array> TopK::vjp(
+    const std::vector<array>& primals,
+    const std::vector<array>& cotangents,
+    const std::vector<int>&,
+    const std::vector<array>& outputs) {
+  // Only the values have a gradient, it goes back to where they came from
+  return {put_along_axis(
+      zeros_like(primals[0], stream()),
+      outputs[1],
+      cotangents[0],
+      axis_,
+      stream())};
+}
+
+std::vector<array> TopK::jvp(
+    const std::vector<array>& primals,
+    const std::vector<array>& tangents,
+    const std::vector<int>&) {
+  auto indices = topk_with_indices(primals[0], k_, axis_, stream()).second;
+  return {
+      take_along_axis(tangents[0], indices, axis_, stream()),
+      zeros_like(indices, stream())};
+}
+
+bool TopK::is_equivalent(const Primitive& other) const {
+  const TopK& t_other = static_cast<const TopK&>(other);
+  return k_ == t_other.k_ && axis_ == t_other.axis_;
+}
+
+std::vector<Shape> TopK::output_shapes(const std::vector<array>& inputs) {
+  auto shape = inputs[0].shape();
+  shape[axis_] = k_;
+  return {shape, shape};
+}
+
 std::vector<array> BlockMaskedMM::vjp(
     const std::vector<array>& primals,
     const std::vector<array>& cotangents,
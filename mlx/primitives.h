@@ -1167,6 +1167,28 @@ class Gather : public UnaryPrimitive {
   Shape slice_sizes_;
 };
 
+class GatherAxis : public UnaryPrimitive {
+ public:
+  explicit GatherAxis(Stream stream, int axis)
+      : UnaryPrimitive(stream), axis_(axis) {}
+
+  void eval_cpu(const std::vector<array>& inputs, array& out) override;
+  void eval_gpu(const std::vector<array>& inputs, array& out) override;
+
+  DEFINE_VMAP()
+  DEFINE_GRADS()
+  DEFINE_PRINT(GatherAxis)
+  bool is_equivalent(const Primitive& other) const override;
+  std::vector<Shape> output_shapes(const std::vector<array>& inputs) override;
+  int state() const {
+    return axis_;
+  }
+
+ private:
+  void eval(const std::vector<array>& inputs, array& out);
+  int axis_;
+};
+
 class Greater : public UnaryPrimitive {
  public:
   explicit Greater(Stream stream) : UnaryPrimitive(stream) {}
@@ -2264,6 +2286,32 @@ class Tanh : public UnaryPrimitive {
   void eval(const std::vector<array>& inputs, array& out);
 };
 
+class TopK : public Primitive {
+ public:
+  explicit TopK(Stream stream, int k, int axis)
+      : Primitive(stream), k_(k), axis_(axis) {}
+
+  void eval_cpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override;
+  void eval_gpu(const std::vector<array>& inputs, std::vector<array>& outputs)
+      override;
+
+  DEFINE_VMAP()
+  DEFINE_GRADS()
+  DEFINE_PRINT(TopK)
+  bool is_equivalent(const Primitive& other) const override;
+  std::vector<Shape> output_shapes(const std::vector<array>& inputs) override;
+  std::pair<int, int> state() const {
+    return {k_, axis_};
+  };
+
+ private:
+  int k_;
+  int axis_;
+
+  void eval(const std::vector<array>& inputs, std::vector<array>& outputs);
+};
+
 class Unflatten : public UnaryPrimitive {
  public:
   explicit Unflatten(Stream stream, int axis, Shape shape)
@@ -0,0 +1,200 @@
+// Copyright © 2024 Apple Inc.
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "mlx/allocator.h"
+#include "mlx/primitives.h"
+#include "mlx/profiler.h"
+#include "mlx/utils.h"
+
+namespace mlx::core::profiler {
+
+namespace detail {
+
+std::atomic<bool> active{false};
+
+struct Record {
+  std::string name;
+  Stream stream;
+  std::vector<std::pair<Shape, Dtype>> inputs;
+  std::vector<std::pair<Shape, Dtype>> outputs;
+  size_t allocated;
+  int64_t start;
+  int64_t end;
+  int thread;
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::Record;
+using clock = std::chrono::steady_clock;
+
+struct Profiler {
+  std::mutex mtx;
+  clock::time_point origin{clock::now()};
+
+  // The ring buffer, next is the total number of records pushed
+  std::vector<Record> records;
+  size_t capacity{0};
+  size_t next{0};
+};
+
+Profiler& profiler() {
+  static Profiler profiler_;
+  return profiler_;
+}
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             clock::now() - profiler().origin)
+      .count();
+}
+
+// Small sequential ids are easier to read in the trace viewer than the native
+// thread ids
+int thread_index() {
+  static std::atomic<int> n_threads{0};
+  thread_local int index = n_threads++;
+  return index;
+}
+
+void write_string(std::ostream& os, const std::string& s) {
+  os << '"';
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          os << ' ';
+        } else {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+
+void write_arrays(
+    std::ostream& os,
+    const std::vector<std::pair<Shape, Dtype>>& arrays) {
+  os << '[';
+  for (int i = 0; i < arrays.size(); i++) {
+    std::ostringstream desc;
+    desc << arrays[i].second << ' ' << arrays[i].first;
+    write_string(os, desc.str());
+    os << (i + 1 < arrays.size() ? "," : "");
+  }
+  os << ']';
+}
+
+void write_record(std::ostream& os, const Record& r) {
+  // Chrome traces are in microseconds
+  os << "{\"name\":";
+  write_string(os, r.name);
+  os << ",\"cat\":\"primitive\",\"ph\":\"X\",\"pid\":0,\"tid\":" << r.thread
+     << ",\"ts\":" << r.start / 1000.0 << ",\"dur\":"
+     << (r.end - r.start) / 1000.0 << ",\"args\":{\"stream\":";
+  std::ostringstream stream;
+  stream << r.stream;
+  write_string(os, stream.str());
+  os << ",\"inputs\":";
+  write_arrays(os, r.inputs);
+  os << ",\"outputs\":";
+  write_arrays(os, r.outputs);
+  os << ",\"bytes_allocated\":" << r.allocated << "}}";
+}
+
+} // namespace
+
+void start(size_t capacity /* = 1 << 16 */) {
+  if (capacity == 0) {
+    throw std::invalid_argument("[profiler::start] Capacity must be positive.");
+  }
+  auto& p = profiler();
+  std::lock_guard<std::mutex> lk(p.mtx);
+  p.records.clear();
+  p.records.reserve(capacity);
+  p.capacity = capacity;
+  p.next = 0;
+  detail::active.store(true, std::memory_order_relaxed);
+}
+
+void stop() {
+  detail::active.store(false, std::memory_order_relaxed);
+}
+
+void save(const std::string& path) {
+  std::ofstream os(path);
+  if (!os.is_open()) {
+    throw std::runtime_error(
+        "[profiler::save] Failed to open " + path + " for writing.");
+  }
+
+  auto& p = profiler();
+  std::lock_guard<std::mutex> lk(p.mtx);
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  // The oldest record is at next once the buffer wrapped around
+  size_t n = p.records.size();
+  size_t first = n > 0 ? p.next % n : 0;
+  for (size_t i = 0; i < n; i++) {
+    write_record(os, p.records[(first + i) % n]);
+    os << (i + 1 < n ? ",\n" : "\n");
+  }
+  os << "]}\n";
+}
+
+namespace detail {
+
+Record* PrimitiveScope::begin(const array& arr) {
+  auto r = new Record{"", arr.primitive().stream()};
+  std::ostringstream name;
+  arr.primitive().print(name);
+  r->name = name.str();
+  for (auto& in : arr.inputs()) {
+    r->inputs.emplace_back(in.shape(), in.dtype());
+  }
+  for (auto& out : arr.outputs()) {
+    r->outputs.emplace_back(out.shape(), out.dtype());
+  }
+  r->thread = thread_index();
+  r->allocated = allocator::get_thread_allocated();
+  r->start = now();
+  return r;
+}
+
+void PrimitiveScope::end(Record* r) {
+  r->end = now();
+  r->allocated = allocator::get_thread_allocated() - r->allocated;
+
+  auto& p = profiler();
+  {
+    std::lock_guard<std::mutex> lk(p.mtx);
+    if (p.capacity > 0) {
+      if (p.records.size() < p.capacity) {
+        p.records.push_back(std::move(*r));
+      } else {
+        p.records[p.next % p.capacity] = std::move(*r);
+      }
+      p.next++;
+    }
+  }
+  delete r;
+}
+
+} // namespace detail
+
+} // namespace mlx::core::profiler
@@ -0,0 +1,65 @@
+// Copyright © 2024 Apple Inc.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "mlx/array.h"
+
+namespace mlx::core::profiler {
+
+/* Start recording the primitives which are executed.
+ *
+ * The records are kept in a ring buffer holding the most recent capacity
+ * primitives. Starting again clears the previous records.
+ * */
+void start(size_t capacity = 1 << 16);
+
+/* Stop recording. The records are kept until the next call to start. */
+void stop();
+
+/* Save the records as a Chrome trace which can be opened in Perfetto or
+ * chrome://tracing.
+ *
+ * GPU primitives are recorded while they are encoded so their timings do not
+ * include the time spent running on the device.
+ * */
+void save(const std::string& path);
+
+namespace detail {
+
+extern std::atomic<bool> active;
+
+inline bool is_active() {
+  return active.load(std::memory_order_relaxed);
+}
+
+struct Record;
+
+// Records the execution of arr's primitive while in scope. It must be
+// constructed before the primitive runs since the array gets detached.
+class PrimitiveScope {
+ public:
+  explicit PrimitiveScope(const array& arr)
+      : record_(is_active() ? begin(arr) : nullptr) {}
+
+  ~PrimitiveScope() {
+    if (record_) {
+      end(record_);
+    }
+  }
+
+  PrimitiveScope(const PrimitiveScope&) = delete;
+  PrimitiveScope& operator=(const PrimitiveScope&) = delete;
+
+ private:
+  static Record* begin(const array& arr);
+  static void end(Record* record);
+
+  Record* record_;
+};
+
+} // namespace detail
+
+} // namespace mlx::core::profiler
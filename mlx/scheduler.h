@@ -3,8 +3,10 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <future>
-#include <queue>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 
@@ -15,24 +17,87 @@
 
 namespace mlx::core::scheduler {
 
+/* A lock-free multi-producer single-consumer queue.
+ *
+ * Producers link a node with one atomic exchange and only the consumer pops
+ * (see Vyukov's intrusive MPSC queue). A pushed node may briefly be invisible
+ * to the consumer until its producer links it, so an empty pop does not mean
+ * that no push is in flight.
+ * */
+template <typename T>
+class MPSCQueue {
+ public:
+  MPSCQueue() : head_(new Node), tail_(head_.load()) {}
+
+  ~MPSCQueue() {
+    while (tail_) {
+      auto next = tail_->next.load(std::memory_order_relaxed);
+      delete tail_;
+      tail_ = next;
+    }
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  template <typename U>
+  void push(U&& value) {
+    auto node = new Node{std::forward<U>(value)};
+    auto prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Only called from the consumer thread
+  bool pop(T& value) {
+    auto next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+    value = std::move(next->value);
+    delete tail_;
+    tail_ = next;
+    return true;
+  }
+
+ private:
+  struct Node {
+    Node() = default;
+    template <typename U>
+    explicit Node(U&& value) : value(std::forward<U>(value)) {}
+
+    std::atomic<Node*> next{nullptr};
+    T value;
+  };
+
+  std::atomic<Node*> head_;
+  Node* tail_;
+};
+
 struct StreamThread {
+  // The number of times an idle thread polls the queue before parking
+  static constexpr int spin_count = 256;
+
+  MPSCQueue<std::function<void()>> q;
   std::mutex mtx;
-  std::queue<std::function<void()>> q;
   std::condition_variable cond;
-  bool stop;
+  std::atomic<bool> sleeping;
+  std::atomic<bool> stop;
   Stream stream;
   std::thread thread;
 
   StreamThread(Stream stream)
-      : stop(false), stream(stream), thread(&StreamThread::thread_fn, this) {
+      : sleeping(false),
+        stop(false),
+        stream(stream),
+        thread(&StreamThread::thread_fn, this) {
     metal::new_stream(stream);
   }
 
   ~StreamThread() {
     synchronize(stream);
+    stop = true;
     {
       std::lock_guard<std::mutex> lk(mtx);
-      stop = true;
     }
     cond.notify_one();
     thread.join();
@@ -41,37 +106,59 @@ struct StreamThread {
   void thread_fn() {
     while (true) {
       std::function<void()> task;
-      {
-        std::unique_lock<std::mutex> lk(mtx);
-        cond.wait(lk, [this] { return !this->q.empty() || this->stop; });
-        if (q.empty() && stop) {
-          return;
-        }
-        task = std::move(q.front());
-        q.pop();
+      if (!next_task(task)) {
+        return;
       }
-
       task();
     }
   }
 
+  // Spin on the queue for a while and then park until a task is pushed.
+  // Returns false once the stream is stopped and drained.
+  bool next_task(std::function<void()>& task) {
+    for (int i = 0; i < spin_count; i++) {
+      if (q.pop(task)) {
+        return true;
+      }
+      if (i >= spin_count / 8) {
+        std::this_thread::yield();
+      }
+    }
+    std::unique_lock<std::mutex> lk(mtx);
+    sleeping = true;
+    // Pairs with the fence in enqueue so that either the producer sees the
+    // thread sleeping or the thread sees the task
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool found = false;
+    cond.wait(lk, [this, &task, &found] {
+      found = q.pop(task);
+      return found || stop;
+    });
+    sleeping = false;
+    return found || q.pop(task);
+  }
+
   template <typename F>
   void enqueue(F&& f) {
-    {
-      std::lock_guard<std::mutex> lk(mtx);
-      if (stop) {
-        throw std::runtime_error(
-            "Cannot enqueue work after stream is stopped.");
+    if (stop) {
+      throw std::runtime_error("Cannot enqueue work after stream is stopped.");
+    }
+    q.push(std::forward<F>(f));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+      // Taking the lock makes sure the thread is either waiting or has yet
+      // to check the queue
+      {
+        std::lock_guard<std::mutex> lk(mtx);
       }
-      q.emplace(std::forward<F>(f));
+      cond.notify_one();
     }
-    cond.notify_one();
   }
 };
 
 class Scheduler {
  public:
-  Scheduler() : n_active_tasks_(0) {
+  Scheduler() : n_active_tasks_(0), n_waiters_(0) {
     if (metal::is_available()) {
       default_streams_.insert({Device::gpu, new_stream(Device::gpu)});
     }
@@ -105,19 +192,13 @@ class Scheduler {
   }
 
   void notify_new_task(const Stream& stream) {
-    {
-      std::lock_guard<std::mutex> lk(mtx);
-      n_active_tasks_++;
-    }
-    completion_cv.notify_all();
+    n_active_tasks_++;
+    notify_waiters();
   }
 
   void notify_task_completion(const Stream& stream) {
-    {
-      std::lock_guard<std::mutex> lk(mtx);
-      n_active_tasks_--;
-    }
-    completion_cv.notify_all();
+    n_active_tasks_--;
+    notify_waiters();
   }
 
   int n_active_tasks() const {
@@ -125,13 +206,17 @@ class Scheduler {
   }
 
   void wait_for_one() {
-    std::unique_lock<std::mutex> lk(mtx);
-    int n_tasks_old = n_active_tasks();
-    if (n_tasks_old > 1) {
-      completion_cv.wait(lk, [this, n_tasks_old] {
-        return this->n_active_tasks() != n_tasks_old;
-      });
+    n_waiters_++;
+    {
+      std::unique_lock<std::mutex> lk(mtx);
+      int n_tasks_old = n_active_tasks();
+      if (n_tasks_old > 1) {
+        completion_cv.wait(lk, [this, n_tasks_old] {
+          return this->n_active_tasks() != n_tasks_old;
+        });
+      }
     }
+    n_waiters_--;
   }
 
   ~Scheduler() {
@@ -141,7 +226,20 @@ class Scheduler {
   }
 
  private:
-  int n_active_tasks_;
+  // The lock is only taken when a thread waits in wait_for_one. The counters
+  // are sequentially consistent so a waiter either sees the new count or is
+  // seen by the notifier.
+  void notify_waiters() {
+    if (n_waiters_ > 0) {
+      {
+        std::lock_guard<std::mutex> lk(mtx);
+      }
+      completion_cv.notify_all();
+    }
+  }
+
+  std::atomic<int> n_active_tasks_;
+  std::atomic<int> n_waiters_;
   std::vector<StreamThread*> streams_;
   std::unordered_map<Device::DeviceType, Stream> default_streams_;
   std::condition_variable completion_cv;
@@ -3,15 +3,20 @@
 #include <deque>
 #include <future>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "mlx/backend/common/graph_executor.h"
+#include "mlx/backend/common/memory_planner.h"
 #include "mlx/backend/metal/metal_impl.h"
+#include "mlx/distributed/primitives.h"
 #include "mlx/ops.h"
 #include "mlx/primitives.h"
+#include "mlx/profiler.h"
 #include "mlx/scheduler.h"
 #include "mlx/transforms.h"
 #include "mlx/transforms_impl.h"
@@ -40,6 +45,105 @@ class Synchronizer : public Primitive {
 int detail::InTracing::tracing_counter{0};
 int detail::RetainGraph::tracing_counter{0};
 
+namespace {
+
+void eval_cpu_node(array& arr) {
+  for (auto& input : arr.inputs()) {
+    if (input.event().valid() &&
+        input.event().stream() != arr.primitive().stream()) {
+      input.event().wait();
+    }
+  }
+  auto outputs = arr.outputs();
+  {
+    profiler::detail::PrimitiveScope profile(arr);
+    arr.primitive().eval_cpu(arr.inputs(), outputs);
+  }
+  if (!arr.is_tracer()) {
+    arr.detach();
+  }
+  for (auto& out : outputs) {
+    out.set_status(array::Status::available);
+  }
+}
+
+// Evaluate a batch of nodes from one CPU stream given in a valid order. The
+// dependencies between them are only known once they are all scheduled so the
+// graph is built here, on the stream thread.
+//
+// n_uses holds the number of times each node is read in the whole eval, if
+// given the outputs only read within the batch are placed in a memory arena.
+void eval_cpu_nodes(
+    std::vector<array>& nodes,
+    const std::unordered_map<std::uintptr_t, int>* n_uses) {
+  if (nodes.size() == 1) {
+    eval_cpu_node(nodes[0]);
+    return;
+  }
+
+  std::unordered_map<std::uintptr_t, int> index;
+  for (int i = 0; i < nodes.size(); i++) {
+    index.insert({nodes[i].id(), i});
+    for (auto& s : nodes[i].siblings()) {
+      index.insert({s.id(), i});
+    }
+  }
+  std::vector<std::vector<int>> consumers(nodes.size());
+  std::vector<int> n_deps(nodes.size(), 0);
+  std::vector<int> n_batch_uses(nodes.size(), 0);
+  int last_collective = -1;
+  for (int i = 0; i < nodes.size(); i++) {
+    for (auto& in : nodes[i].inputs()) {
+      if (auto it = index.find(in.id()); it != index.end()) {
+        consumers[it->second].push_back(i);
+        n_deps[i]++;
+        n_batch_uses[it->second]++;
+      }
+    }
+    // Collective operations must run in the same order on every process
+    if (dynamic_cast<distributed::DistPrimitive*>(&nodes[i].primitive())) {
+      if (last_collective >= 0) {
+        consumers[last_collective].push_back(i);
+        n_deps[i]++;
+      }
+      last_collective = i;
+    }
+  }
+
+  // Plan the outputs which are only read within the batch. The last node
+  // outlives the batch to signal its event.
+  std::optional<cpu::MemoryArena> arena;
+  if (n_uses) {
+    std::vector<size_t> sizes(nodes.size(), 0);
+    for (int i = 0; i + 1 < nodes.size(); i++) {
+      auto& node = nodes[i];
+      if (node.siblings().empty() && !node.is_tracer()) {
+        auto it = n_uses->find(node.id());
+        if (it != n_uses->end() && it->second == n_batch_uses[i]) {
+          sizes[i] = node.nbytes();
+        }
+      }
+    }
+    arena.emplace(cpu::plan_memory(consumers, sizes));
+  }
+
+  cpu::run_graph(consumers, std::move(n_deps), [&nodes, &arena](int i) {
+    if (arena) {
+      cpu::MemoryArena::NodeScope scope(*arena, i);
+      eval_cpu_node(nodes[i]);
+    } else {
+      eval_cpu_node(nodes[i]);
+    }
+    // Release the node so that its buffers can be freed as soon as its
+    // consumers are done. The last one is kept to signal its event.
+    if (i + 1 < nodes.size()) {
+      auto done = std::move(nodes[i]);
+    }
+  });
+}
+
+} // namespace
+
 array eval_impl(std::vector<array> outputs, bool async) {
   std::deque<array> tape;
 
@@ -57,6 +161,9 @@ array eval_impl(std::vector<array> outputs, bool async) {
 
   std::unordered_set<uintptr_t> needs_signal;
 
+  // The number of reads of each array, used to plan the memory on the CPU
+  std::shared_ptr<std::unordered_map<std::uintptr_t, int>> n_uses;
+
   auto synchronizer = array(
       {}, bool_, std::make_shared<Synchronizer>(stream), std::move(outputs));
   needs_signal.insert(synchronizer.id());
@@ -132,6 +239,10 @@ array eval_impl(std::vector<array> outputs, bool async) {
       dfs.pop();
     }
 
+    if (env::cpu_memory_planning()) {
+      n_uses = std::make_shared<std::unordered_map<std::uintptr_t, int>>(cache);
+    }
+
     // Build the tape in BFS order with a width limit
     int max_width = env::bfs_max_width();
     dfs = std::stack<std::pair<std::reference_wrapper<array>, int>>();
@@ -179,6 +290,29 @@ array eval_impl(std::vector<array> outputs, bool async) {
     }
   }
 
+  // CPU nodes are grouped per stream into batches which run as a single task
+  // on the stream thread. Nodes of a batch that do not depend on each other
+  // run in parallel. A batch starts at a node which waits on another stream
+  // and ends at a node which signals one, so that the events are signaled in
+  // order and a node never waits on a batch that is still running.
+  std::unordered_map<int, std::vector<array>> cpu_batches;
+  auto flush = [&cpu_batches, &n_uses](const Stream& stream, bool signal) {
+    auto& batch = cpu_batches[stream.index];
+    if (batch.empty()) {
+      return;
+    }
+    auto task = [nodes = std::move(batch), n_uses, stream, signal]() mutable {
+      scheduler::notify_new_task(stream);
+      eval_cpu_nodes(nodes, n_uses.get());
+      if (signal) {
+        nodes.back().event().signal();
+      }
+      scheduler::notify_task_completion(stream);
+    };
+    batch = std::vector<array>();
+    scheduler::enqueue(stream, std::move(task));
+  };
+
   while (!tape.empty()) {
     auto arr = std::move(tape.back());
     tape.pop_back();
@@ -202,7 +336,6 @@ array eval_impl(std::vector<array> outputs, bool async) {
       s.set_status(array::Status::scheduled);
     }
 
-    std::vector<std::shared_future<void>> arr_deps;
     bool signal = needs_signal.find(arr.id()) != needs_signal.end();
 
     if (arr.primitive().device() == Device::gpu) {
@@ -211,30 +344,22 @@ array eval_impl(std::vector<array> outputs, bool async) {
       }
       scheduler::enqueue(stream, metal::make_task(std::move(arr), signal));
     } else {
-      auto task = [arr = std::move(arr), stream, signal]() mutable {
-        for (auto& input : arr.inputs()) {
-          if (input.event().valid() &&
-              input.event().stream() != arr.primitive().stream()) {
-            input.event().wait();
-          }
-        }
-        scheduler::notify_new_task(stream);
-        auto outputs = arr.outputs();
-        arr.primitive().eval_cpu(arr.inputs(), outputs);
-        if (!arr.is_tracer()) {
-          arr.detach();
-        }
-        for (auto& out : outputs) {
-          out.set_status(array::Status::available);
-        }
-
-        if (signal) {
-          arr.event().signal();
+      for (auto& input : arr.inputs()) {
+        if (input.event().valid() && input.event().stream() != stream &&
+            !input.event().is_signaled()) {
+          flush(stream, false);
+          break;
         }
-
-        scheduler::notify_task_completion(stream);
-      };
-      scheduler::enqueue(stream, std::move(task));
+      }
+      cpu_batches[stream.index].push_back(std::move(arr));
+      if (signal) {
+        flush(stream, true);
+      }
+    }
+  }
+  for (auto& [index, batch] : cpu_batches) {
+    if (!batch.empty()) {
+      flush(batch.front().primitive().stream(), false);
     }
   }
   return synchronizer;
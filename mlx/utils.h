@@ -122,6 +122,31 @@ inline int max_ops_per_buffer() {
   return max_ops_per_buffer_;
 }
 
+inline int cpu_num_threads() {
+  static int cpu_num_threads_ = get_var("MLX_CPU_NUM_THREADS", 0);
+  return cpu_num_threads_;
+}
+
+inline bool cpu_memory_planning() {
+  static bool cpu_memory_planning_ = get_var("MLX_CPU_MEMORY_PLANNING", 1);
+  return cpu_memory_planning_;
+}
+
+// Reduce within each host before reducing across hosts in distributed
+// all reduce operations.
+inline bool distributed_hierarchical() {
+  static bool distributed_hierarchical_ =
+      get_var("MLX_DISTRIBUTED_HIERARCHICAL", 1);
+  return distributed_hierarchical_;
+}
+
+// In megabytes. 0 disables the persistent cache.
+inline int cpu_kernel_cache_size() {
+  static int cpu_kernel_cache_size_ =
+      get_var("MLX_CPU_KERNEL_CACHE_SIZE", 512);
+  return cpu_kernel_cache_size_;
+}
+
 } // namespace env
 
 } // namespace mlx::core
@@ -80,7 +80,12 @@ def average_gradients(
     """Average the gradients across the distributed processes in the passed group.
 
     This helper enables concatenating several gradients of small arrays to one
-    big all reduce call for better networking performance.
+    big all reduce call for better networking performance. Gradients of
+    different types are grouped separately.
+
+    The reductions run on a dedicated communication stream, so each group is
+    reduced as soon as its gradients are computed while the rest of the
+    computation proceeds.
 
     Args:
         gradients (Any): The Python tree containing the gradients (it should
@@ -120,32 +125,28 @@ def average_gradients(
         sizes = [v.size for _, v in flat_grads]
         dtypes = [v.dtype for _, v in flat_grads]
 
-        # We can't group them if they have mixed types
-        if not all(dt == dtypes[0] for dt in dtypes):
-            return average_gradients(gradients, group, 0, communication_type)
-        itemsize = (
-            communication_type.size
-            if communication_type is not None
-            else dtypes[0].size
-        )
-
-        # Gather the gradients in groups that are just above or equal to all_reduce_size
+        # Gather the gradients in groups that are just above or equal to
+        # all_reduce_size. Arrays of different types go to different groups.
         grad_groups = []
-        grad_group = []
-        grad_group_size = 0
+        open_groups = {}
         for i in range(len(keys)):
+            itemsize = (
+                communication_type.size
+                if communication_type is not None
+                else dtypes[i].size
+            )
+            grad_group, grad_group_size = open_groups.get(dtypes[i], ([], 0))
             grad_group.append(i)
             grad_group_size += sizes[i] * itemsize
             if grad_group_size >= all_reduce_size:
                 grad_groups.append(grad_group)
-                grad_group = []
-                grad_group_size = 0
-        if grad_group:
-            grad_groups.append(grad_group)
-            grad_group = []
+                open_groups.pop(dtypes[i], None)
+            else:
+                open_groups[dtypes[i]] = (grad_group, grad_group_size)
+        grad_groups.extend(grad_group for grad_group, _ in open_groups.values())
 
         # Concatenate-reduce-split
-        new_flat_grads = []
+        new_flat_grads = [None] * len(keys)
         for grad_group in grad_groups:
             indices = reduce(lambda x, y: x + [x[-1] + sizes[y]], grad_group, [0])
             big_grad = mx.concatenate(
@@ -153,9 +154,7 @@ def average_gradients(
             )
             big_grad = _average(big_grad)
             big_grad = mx.split(big_grad, indices[1:-1])
-            new_flat_grads.extend(
-                (keys[j], big_grad[i].reshape(shapes[j]))
-                for i, j in enumerate(grad_group)
-            )
+            for i, j in enumerate(grad_group):
+                new_flat_grads[j] = (keys[j], big_grad[i].reshape(shapes[j]))
 
         return tree_unflatten(new_flat_grads)
@@ -5,6 +5,7 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/string.h>
 
+#include "mlx/backend/common/threading.h"
 #include "mlx/device.h"
 #include "mlx/utils.h"
 
@@ -58,4 +59,27 @@ void init_device(nb::module_& m) {
       &mx::set_default_device,
       "device"_a,
       R"pbdoc(Set the default device.)pbdoc");
+  m.def(
+      "get_num_threads",
+      &mx::cpu::get_num_threads,
+      R"pbdoc(
+      Get the number of threads used to parallelize a single CPU operation.
+      )pbdoc");
+  m.def(
+      "set_num_threads",
+      &mx::cpu::set_num_threads,
+      "num_threads"_a,
+      R"pbdoc(
+      Set the number of threads used to parallelize a single CPU operation.
+
+      The default is the value of the ``MLX_CPU_NUM_THREADS`` environment
+      variable or, if it is not set, the number of hardware threads. Use
+      ``1`` to run each CPU operation on its stream's thread only.
+
+      Args:
+        num_threads (int): The number of threads including the stream thread.
+
+      Returns:
+        int: The previous number of threads.
+      )pbdoc");
 }
@@ -2,7 +2,9 @@
 
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/optional.h>
+#include <nanobind/stl/pair.h>
 #include <nanobind/stl/shared_ptr.h>
+#include <nanobind/stl/string.h>
 #include <nanobind/stl/variant.h>
 #include <nanobind/stl/vector.h>
 
@@ -58,14 +60,18 @@ void init_distributed(nb::module_& parent_module) {
       "init",
       &mx::distributed::init,
       "strict"_a = false,
-      nb::sig("def init(strict: bool = False) -> Group"),
+      "backend"_a = "any",
+      nb::sig("def init(strict: bool = False, backend: str = 'any') -> Group"),
       R"pbdoc(
         Initialize the communication backend and create the global communication group.
 
         Args:
           strict (bool, optional): If set to False it returns a singleton group
-            in case ``mx.distributed.is_available()`` returns False otherwise
-            it throws a runtime error. Default: ``False``
+            in case the requested backend can't be initialized otherwise it
+            throws a runtime error. Default: ``False``
+          backend (str, optional): Which distributed backend to initialize.
+            Possible values ``mpi``, ``ring``, ``any``. If ``any`` then MPI is
+            tried first and the ring backend second. Default: ``any``
 
         Returns:
           Group: The group representing all the launched processes.
@@ -97,6 +103,118 @@ void init_distributed(nb::module_& parent_module) {
           array: The sum of all ``x`` arrays.
       )pbdoc");
 
+  m.def(
+      "all_sum_compressed",
+      &mx::distributed::all_sum_compressed,
+      "x"_a,
+      "wire_type"_a,
+      "residual"_a = nb::none(),
+      "group_size"_a = 64,
+      nb::kw_only(),
+      "group"_a = nb::none(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def all_sum_compressed(x: array, wire_type: Dtype, residual: Optional[array] = None, group_size: int = 64, *, group: Optional[Group] = None, stream: Union[None, Stream, Device] = None) -> tuple[array, array]"),
+      R"pbdoc(
+        All reduce sum with a compressed wire format.
+
+        Sum the ``x`` arrays from all processes in the group while sending
+        less data than :func:`all_sum`. With ``float16`` or ``bfloat16`` the
+        arrays are cast before the reduction. With ``int8`` they are quantized
+        in blocks of ``group_size`` elements with a scale and a bias per block.
+        Each process sums its own slice of the quantized arrays, then the
+        quantized sums are gathered. This sends about a quarter of the data of
+        a ``float32`` :func:`all_sum`.
+
+        The error made when compressing ``x`` is returned along with the sum.
+        Passing it as the ``residual`` of the next call for the same array adds
+        it back, so the compression errors do not accumulate over training
+        steps.
+
+        Args:
+          x (array): Input floating point array.
+          wire_type (Dtype): The format used for the communication, one of
+            ``float16``, ``bfloat16`` or ``int8``.
+          residual (array, optional): The compression error returned by the
+            previous call for this array. Default: ``None``.
+          group_size (int, optional): The number of elements quantized with
+            the same scale and bias when ``wire_type`` is ``int8``. Default:
+            ``64``.
+          group (Group): The group of processes that will participate in the
+            reduction. If set to ``None`` the global group is used. Default:
+            ``None``.
+          stream (Stream, optional): Stream or device. Defaults to ``None``
+            in which case the default stream of the default device is used.
+
+        Returns:
+          tuple(array, array): The sum of all ``x`` arrays and the compression
+          error of ``x``.
+
+        Example:
+
+          .. code-block:: python
+
+            residuals = {}
+            for name, g in gradients.items():
+                s, residuals[name] = mx.distributed.all_sum_compressed(
+                    g, mx.int8, residual=residuals.get(name)
+                )
+      )pbdoc");
+
+  m.def(
+      "all_max",
+      &mx::distributed::all_max,
+      "x"_a,
+      nb::kw_only(),
+      "group"_a = nb::none(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def all_max(x: array, *, group: Optional[Group] = None, stream: Union[None, Stream, Device] = None) -> array"),
+      R"pbdoc(
+        All reduce max.
+
+        Find the element-wise maximum of the ``x`` arrays from all processes in
+        the group.
+
+        Args:
+          x (array): Input array.
+          group (Group): The group of processes that will participate in the
+            reduction. If set to ``None`` the global group is used. Default:
+            ``None``.
+          stream (Stream, optional): Stream or device. Defaults to ``None``
+            in which case the default stream of the default device is used.
+
+        Returns:
+          array: The element-wise maximum of all ``x`` arrays.
+      )pbdoc");
+
+  m.def(
+      "all_min",
+      &mx::distributed::all_min,
+      "x"_a,
+      nb::kw_only(),
+      "group"_a = nb::none(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def all_min(x: array, *, group: Optional[Group] = None, stream: Union[None, Stream, Device] = None) -> array"),
+      R"pbdoc(
+        All reduce min.
+
+        Find the element-wise minimum of the ``x`` arrays from all processes in
+        the group.
+
+        Args:
+          x (array): Input array.
+          group (Group): The group of processes that will participate in the
+            reduction. If set to ``None`` the global group is used. Default:
+            ``None``.
+          stream (Stream, optional): Stream or device. Defaults to ``None``
+            in which case the default stream of the default device is used.
+
+        Returns:
+          array: The element-wise minimum of all ``x`` arrays.
+      )pbdoc");
+
   m.def(
       "all_gather",
       &mx::distributed::all_gather,
@@ -124,6 +242,94 @@ void init_distributed(nb::module_& parent_module) {
           array: The concatenation of all ``x`` arrays.
       )pbdoc");
 
+  m.def(
+      "reduce_scatter",
+      &mx::distributed::reduce_scatter,
+      "x"_a,
+      nb::kw_only(),
+      "group"_a = nb::none(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def reduce_scatter(x: array, *, group: Optional[Group] = None, stream: Union[None, Stream, Device] = None) -> array"),
+      R"pbdoc(
+        Sum arrays from all processes and scatter the result.
+
+        Sum the ``x`` arrays from all processes in the group and split the
+        result along the first axis in one part per process. Each process
+        receives the part that matches its rank. The first dimension of ``x``
+        must be divisible by the size of the group.
+
+        Args:
+          x (array): Input array.
+          group (Group): The group of processes that will participate in the
+            reduction. If set to ``None`` the global group is used. Default:
+            ``None``.
+          stream (Stream, optional): Stream or device. Defaults to ``None``
+            in which case the default stream of the default device is used.
+
+        Returns:
+          array: The part of the sum of all ``x`` arrays that belongs to this
+          process.
+      )pbdoc");
+
+  m.def(
+      "broadcast",
+      &mx::distributed::broadcast,
+      "x"_a,
+      "root"_a,
+      nb::kw_only(),
+      "group"_a = nb::none(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def broadcast(x: array, root: int, *, group: Optional[Group] = None, stream: Union[None, Stream, Device] = None) -> array"),
+      R"pbdoc(
+        Broadcast an array from the process with rank ``root``.
+
+        Every process returns the ``x`` of the root process. The arrays should
+        all have the same shape and type.
+
+        Args:
+          x (array): Input array.
+          root (int): Rank of the process whose array is broadcast.
+          group (Group): The group of processes that will participate in the
+            broadcast. If set to ``None`` the global group is used. Default:
+            ``None``.
+          stream (Stream, optional): Stream or device. Defaults to ``None``
+            in which case the default stream of the default device is used.
+
+        Returns:
+          array: The ``x`` array of the root process.
+      )pbdoc");
+
+  m.def(
+      "all_to_all",
+      &mx::distributed::all_to_all,
+      "x"_a,
+      nb::kw_only(),
+      "group"_a = nb::none(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def all_to_all(x: array, *, group: Optional[Group] = None, stream: Union[None, Stream, Device] = None) -> array"),
+      R"pbdoc(
+        Exchange parts of an array between all processes.
+
+        Split ``x`` along the first axis in one part per process and send the
+        ``i``-th part to the process with rank ``i``. The received parts are
+        concatenated in rank order. The first dimension of ``x`` must be
+        divisible by the size of the group.
+
+        Args:
+          x (array): Input array.
+          group (Group): The group of processes that will participate in the
+            exchange. If set to ``None`` the global group is used. Default:
+            ``None``.
+          stream (Stream, optional): Stream or device. Defaults to ``None``
+            in which case the default stream of the default device is used.
+
+        Returns:
+          array: The parts of ``x`` sent to this process by every process.
+      )pbdoc");
+
   m.def(
       "send",
       &mx::distributed::send,
@@ -170,9 +170,17 @@ class PyFileReader : public mx::io::Reader {
 std::pair<
     std::unordered_map<std::string, mx::array>,
     std::unordered_map<std::string, std::string>>
-mlx_load_safetensor_helper(nb::object file, mx::StreamOrDevice s) {
+mlx_load_safetensor_helper(nb::object file, bool mmap, mx::StreamOrDevice s) {
   if (nb::isinstance<nb::str>(file)) { // Assume .safetensors file path string
-    return mx::load_safetensors(nb::cast<std::string>(file), s);
+    auto fname = nb::cast<std::string>(file);
+    if (mmap) {
+      return mx::load_safetensors(
+          std::make_shared<mx::io::MappedFileReader>(fname), s);
+    }
+    return mx::load_safetensors(fname, s);
+  } else if (mmap) {
+    throw std::invalid_argument(
+        "[load_safetensors] Memory mapping requires a file path");
   } else if (is_istream_object(file)) {
     // If we don't own the stream and it was passed to us, eval immediately
     auto res = mx::load_safetensors(std::make_shared<PyFileReader>(file), s);
@@ -260,6 +268,7 @@ LoadOutputTypes mlx_load_helper(
     nb::object file,
     std::optional<std::string> format,
     bool return_metadata,
+    bool mmap,
     mx::StreamOrDevice s) {
   if (!format.has_value()) {
     std::string fname;
@@ -283,8 +292,12 @@ LoadOutputTypes mlx_load_helper(
     throw std::invalid_argument(
         "[load] metadata not supported for format " + format.value());
   }
+  if (mmap && format.value() != "safetensors") {
+    throw std::invalid_argument(
+        "[load] Memory mapping is not supported for format " + format.value());
+  }
   if (format.value() == "safetensors") {
-    auto [dict, metadata] = mlx_load_safetensor_helper(file, s);
+    auto [dict, metadata] = mlx_load_safetensor_helper(file, mmap, s);
     if (return_metadata) {
       return std::make_pair(dict, metadata);
     }
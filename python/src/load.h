@@ -25,6 +25,7 @@ using LoadOutputTypes = std::variant<
 
 mx::SafetensorsLoad mlx_load_safetensor_helper(
     nb::object file,
+    bool mmap,
     mx::StreamOrDevice s);
 void mlx_save_safetensor_helper(
     nb::object file,
@@ -42,6 +43,7 @@ LoadOutputTypes mlx_load_helper(
     nb::object file,
     std::optional<std::string> format,
     bool return_metadata,
+    bool mmap,
     mx::StreamOrDevice s);
 void mlx_save_helper(nb::object file, mx::array a);
 void mlx_savez_helper(
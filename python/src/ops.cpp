@@ -659,6 +659,8 @@ void init_ops(nb::module_& m) {
           two dimensions of each input.
         - All but the last two dimensions of each input are broadcast with one another using
           standard numpy-style broadcasting semantics.
+        - If both arrays are ``int8`` the product is computed exactly and the
+          result is ``int32``. This is currently only supported on the CPU.
 
         Args:
             a (array): Input array or scalar.
@@ -2745,6 +2747,44 @@ void init_ops(nb::module_& m) {
         Returns:
             array: The top ``k`` elements from the input.
       )pbdoc");
+  m.def(
+      "topk_with_indices",
+      [](const mx::array& a,
+         int k,
+         std::optional<int> axis,
+         mx::StreamOrDevice s) {
+        if (axis) {
+          return mx::topk_with_indices(a, k, *axis, s);
+        } else {
+          return mx::topk_with_indices(a, k, s);
+        }
+      },
+      nb::arg(),
+      "k"_a,
+      "axis"_a.none() = -1,
+      nb::kw_only(),
+      "stream"_a = nb::none(),
+      nb::sig(
+          "def topk_with_indices(a: array, /, k: int, axis: Union[None, int] = -1, *, stream: Union[None, Stream, Device] = None) -> tuple[array, array]"),
+      R"pbdoc(
+        Returns the ``k`` largest elements from the input along a given axis
+        together with their indices.
+
+        The elements will not necessarily be in sorted order but the values
+        and indices are in the same order.
+
+        Args:
+            a (array): Input array.
+            k (int): ``k`` top elements to be returned
+            axis (int or None, optional): Optional axis to select over.
+              If ``None``, this selects the top ``k`` elements over the
+              flattened array and returns indices into it. If unspecified,
+              it defaults to ``-1``.
+
+        Returns:
+            tuple(array, array): The top ``k`` elements from the input and
+            their ``uint32`` indices.
+      )pbdoc");
   m.def(
       "broadcast_to",
       [](const ScalarOrArray& a, const mx::Shape& shape, mx::StreamOrDevice s) {
@@ -3851,9 +3891,10 @@ void init_ops(nb::module_& m) {
       "format"_a = nb::none(),
       "return_metadata"_a = false,
       nb::kw_only(),
+      "mmap"_a = false,
       "stream"_a = nb::none(),
       nb::sig(
-          "def load(file: str, /, format: Optional[str] = None, return_metadata: bool = False, *, stream: Union[None, Stream, Device] = None) -> Union[array, dict[str, array]]"),
+          "def load(file: str, /, format: Optional[str] = None, return_metadata: bool = False, *, mmap: bool = False, stream: Union[None, Stream, Device] = None) -> Union[array, dict[str, array]]"),
       R"pbdoc(
         Load array(s) from a binary file.
 
@@ -3868,6 +3909,11 @@ void init_ops(nb::module_& m) {
             return_metadata (bool, optional): Load the metadata for formats
               which support matadata. The metadata will be returned as an
               additional dictionary. Default: ``False``.
+            mmap (bool, optional): Memory map the file instead of reading it.
+              Only supported for ``.safetensors`` file paths. On the CPU the
+              arrays are backed directly by the file's pages which are only
+              read when the arrays are used. Writing to the arrays never
+              modifies the file. Default: ``False``.
         Returns:
             array or dict:
                 A single array if loading from a ``.npy`` file or a dict
@@ -0,0 +1,52 @@
+// Copyright © 2024 Apple Inc.
+
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/string.h>
+
+#include "mlx/profiler.h"
+
+namespace mx = mlx::core;
+namespace nb = nanobind;
+using namespace nb::literals;
+
+void init_profiler(nb::module_& m) {
+  nb::module_ profiler = m.def_submodule("profiler", "mlx.profiler");
+  profiler.def(
+      "start",
+      &mx::profiler::start,
+      "capacity"_a = 1 << 16,
+      R"pbdoc(
+      Start recording the primitives which are executed.
+
+      Each record holds the name of the primitive, its stream, the shapes and
+      types of its inputs and outputs, the bytes it allocated, the thread it
+      ran on and its start and end time.
+
+      Args:
+        capacity (int, optional): The number of most recent primitives to
+          keep. Default: ``65536``.
+      )pbdoc");
+  profiler.def(
+      "stop",
+      &mx::profiler::stop,
+      R"pbdoc(
+      Stop recording. The records are kept until the next call to
+      :func:`start`.
+      )pbdoc");
+  profiler.def(
+      "save",
+      &mx::profiler::save,
+      "path"_a,
+      R"pbdoc(
+      Save the records as a Chrome trace.
+
+      The trace can be opened in `Perfetto <https://ui.perfetto.dev>`_ or
+      ``chrome://tracing``. GPU primitives are recorded while they are
+      encoded so their timings do not include the time spent running on the
+      device.
+
+      Args:
+        path (str): The path to save the trace which should have the
+          extension ``.json``.
+      )pbdoc");
+}
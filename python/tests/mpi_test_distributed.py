@@ -94,6 +94,114 @@ class TestDistributed(mlx_tests.MLXTestCase):
 
         self.assertTrue(mx.all(z == z_target))
 
+    def test_all_sum_compressed(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+
+        # Small integers are exact in half precision
+        x = mx.arange(100).astype(mx.float32) + rank
+        target = mx.arange(100) * size + size * (size - 1) // 2
+        y, err = mx.distributed.all_sum_compressed(x, mx.float16)
+        self.assertEqual(y.dtype, mx.float32)
+        self.assertTrue(mx.array_equal(y, target))
+        self.assertTrue(mx.all(err == 0))
+
+        y, err = mx.distributed.all_sum_compressed(x, mx.bfloat16)
+        self.assertTrue(mx.allclose(y, target, rtol=1e-2))
+
+        # Block quantization with error feedback
+        mx.random.seed(rank)
+        x = mx.random.normal((100, 33))
+        y, err = mx.distributed.all_sum_compressed(x, mx.int8)
+        self.assertEqual(y.shape, x.shape)
+        self.assertTrue(mx.allclose(y, mx.distributed.all_sum(x), atol=0.2))
+        self.assertTrue(mx.abs(err).max() < 0.05)
+
+        y, _ = mx.distributed.all_sum_compressed(x, mx.int8, residual=err)
+        self.assertTrue(mx.allclose(y, mx.distributed.all_sum(x + err), atol=0.2))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.all_sum_compressed(x, mx.int8, residual=mx.zeros(3))
+        with self.assertRaises(ValueError):
+            mx.distributed.all_sum_compressed(mx.ones(4, mx.int32), mx.float16)
+        with self.assertRaises(ValueError):
+            mx.distributed.all_sum_compressed(x, mx.uint8)
+
+    def test_all_max_min(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        for dt in [mx.int32, mx.uint8, mx.float32, mx.float16, mx.bfloat16]:
+            x = (mx.arange(16) + rank).astype(dt)
+            self.assertTrue(mx.all(mx.distributed.all_max(x) == x - rank + size - 1))
+            self.assertTrue(mx.all(mx.distributed.all_min(x) == x - rank))
+
+        # The gradient goes to the rank holding the maximum
+        x = mx.array([float(rank), -float(rank)])
+        dfdx = mx.grad(lambda x: mx.distributed.all_max(x).sum())(x)
+        expected = [1.0 if rank == size - 1 else 0.0, 1.0 if rank == 0 else 0.0]
+        self.assertTrue(mx.array_equal(dfdx, mx.array(expected)))
+
+    def test_reduce_scatter(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        for dt in [mx.int32, mx.float32, mx.float16]:
+            x = (mx.arange(size * 6).reshape(size * 2, 3) * (rank + 1)).astype(dt)
+            y = mx.distributed.reduce_scatter(x)
+            total = size * (size + 1) // 2
+            expected = mx.arange(size * 6).reshape(size * 2, 3) * total
+            self.assertEqual(y.shape, (2, 3))
+            self.assertTrue(mx.array_equal(y, expected[2 * rank : 2 * rank + 2]))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.reduce_scatter(mx.ones((size + 1,)))
+
+        # The gradient is gathered from every rank
+        x = mx.ones((size, 4))
+        dfdx = mx.grad(lambda x: (mx.distributed.reduce_scatter(x) * (rank + 1)).sum())(
+            x
+        )
+        expected = mx.broadcast_to(mx.arange(1, size + 1)[:, None], (size, 4))
+        self.assertTrue(mx.array_equal(dfdx, expected.astype(mx.float32)))
+
+        # vmap over the first axis keeps splitting the unbatched first axis
+        x = mx.arange(3 * size * 2).reshape(3, size * 2)
+        y = mx.vmap(mx.distributed.reduce_scatter)(x)
+        expected = (x * size)[:, 2 * rank : 2 * rank + 2]
+        self.assertTrue(mx.array_equal(y, expected))
+
+    def test_broadcast(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        for root in range(size):
+            x = mx.full((1000, 10), rank)
+            y = mx.distributed.broadcast(x, root)
+            self.assertTrue(mx.all(y == root))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.broadcast(mx.ones(2), size)
+
+        # Only the root gets a gradient, summed over every rank
+        dfdx = mx.grad(lambda x: mx.distributed.broadcast(x, 0).sum())(mx.ones(3))
+        self.assertTrue(mx.all(dfdx == (size if rank == 0 else 0)))
+
+    def test_all_to_all(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        x = mx.arange(size * 3).reshape(size, 3) + 100 * rank
+        y = mx.distributed.all_to_all(x)
+        expected = mx.arange(size)[:, None] * 100 + mx.arange(3) + 3 * rank
+        self.assertTrue(mx.array_equal(y, expected))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.all_to_all(mx.ones((size + 1,)))
+
+        # The exchange is its own transpose
+        cotan = mx.arange(size * 2).reshape(size, 2).astype(mx.float32) + rank
+        _, vjps = mx.vjp(
+            lambda x: mx.distributed.all_to_all(x), [mx.zeros((size, 2))], [cotan]
+        )
+        self.assertTrue(mx.array_equal(vjps[0], mx.distributed.all_to_all(cotan)))
+
     def test_send_recv(self):
         world = mx.distributed.init()
         pairs = world.split(world.rank() // 2)
@@ -161,6 +269,20 @@ class TestDistributed(mlx_tests.MLXTestCase):
             self.assertTrue(all(mx.all(g == 1) for g in new_grads))
             self.assertEqual(n_calls, 2)
 
+            # Mixed types are grouped per type instead of one call per array
+            n_calls = 0
+            xtype = None
+            grads = [
+                mx.ones(10, dtype=mx.float16 if i % 2 else mx.float32)
+                for i in range(10)
+            ]
+            new_grads = average_gradients(grads)
+            mx.eval(new_grads)
+            self.assertEqual(len(new_grads), 10)
+            self.assertTrue(all(g.dtype == x.dtype for g, x in zip(new_grads, grads)))
+            self.assertTrue(all(mx.all(g == 1) for g in new_grads))
+            self.assertEqual(n_calls, 2)
+
         finally:
             mx.distributed.all_sum = original_all_sum
 
@@ -0,0 +1,190 @@
+# Copyright © 2024 Apple Inc.
+
+import unittest
+
+import mlx.core as mx
+import mlx_tests
+
+
+class TestRingDistributed(mlx_tests.MLXTestCase):
+    @classmethod
+    def setUpClass(cls):
+        mx.distributed.init(strict=True, backend="ring")
+
+    def test_groups(self):
+        world = mx.distributed.init()
+        self.assertEqual(world.size(), 8)
+        self.assertTrue(0 <= world.rank() < 8)
+
+        world2 = mx.distributed.init()
+        self.assertEqual(world.size(), world2.size())
+        self.assertEqual(world.rank(), world2.rank())
+
+        with self.assertRaises(RuntimeError):
+            world.split(world.rank() % 2)
+
+    def test_all_reduce(self):
+        world = mx.distributed.init()
+        dtypes = [
+            mx.int8,
+            mx.uint8,
+            mx.int16,
+            mx.uint16,
+            mx.int32,
+            mx.uint32,
+            mx.float32,
+            mx.float16,
+            mx.bfloat16,
+            mx.complex64,
+        ]
+        sizes = [(7,), (10,), (1024,), (1024, 1024)]
+        for dt in dtypes:
+            for sh in sizes:
+                x = mx.ones(sh, dtype=dt)
+                y = mx.distributed.all_sum(x)
+                self.assertTrue(mx.all(y == world.size()))
+
+        x = mx.arange(1000) * world.rank()
+        y = mx.distributed.all_sum(x)
+        self.assertTrue(mx.array_equal(y, mx.arange(1000) * 28))
+
+    def test_all_gather(self):
+        world = mx.distributed.init()
+        for sh in [(1,), (2, 2, 4), (256, 1024)]:
+            x = mx.full(sh, world.rank(), dtype=mx.int32)
+            y = mx.distributed.all_gather(x)
+            self.assertEqual(y.shape, (world.size() * sh[0], *sh[1:]))
+            for r in range(world.size()):
+                part = y[r * sh[0] : (r + 1) * sh[0]]
+                self.assertTrue(mx.all(part == r))
+
+    def test_all_sum_compressed(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+
+        # Small integers are exact in half precision
+        x = mx.arange(100).astype(mx.float32) + rank
+        target = mx.arange(100) * size + size * (size - 1) // 2
+        y, err = mx.distributed.all_sum_compressed(x, mx.float16)
+        self.assertEqual(y.dtype, mx.float32)
+        self.assertTrue(mx.array_equal(y, target))
+        self.assertTrue(mx.all(err == 0))
+
+        y, err = mx.distributed.all_sum_compressed(x, mx.bfloat16)
+        self.assertTrue(mx.allclose(y, target, rtol=1e-2))
+
+        # Block quantization with error feedback
+        mx.random.seed(rank)
+        x = mx.random.normal((100, 33))
+        y, err = mx.distributed.all_sum_compressed(x, mx.int8)
+        self.assertEqual(y.shape, x.shape)
+        self.assertTrue(mx.allclose(y, mx.distributed.all_sum(x), atol=0.2))
+        self.assertTrue(mx.abs(err).max() < 0.05)
+
+        y, _ = mx.distributed.all_sum_compressed(x, mx.int8, residual=err)
+        self.assertTrue(mx.allclose(y, mx.distributed.all_sum(x + err), atol=0.2))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.all_sum_compressed(x, mx.int8, residual=mx.zeros(3))
+        with self.assertRaises(ValueError):
+            mx.distributed.all_sum_compressed(mx.ones(4, mx.int32), mx.float16)
+        with self.assertRaises(ValueError):
+            mx.distributed.all_sum_compressed(x, mx.uint8)
+
+    def test_all_max_min(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        for dt in [mx.int32, mx.uint8, mx.float32, mx.float16, mx.bfloat16]:
+            x = (mx.arange(16) + rank).astype(dt)
+            self.assertTrue(mx.all(mx.distributed.all_max(x) == x - rank + size - 1))
+            self.assertTrue(mx.all(mx.distributed.all_min(x) == x - rank))
+
+        # The gradient goes to the rank holding the maximum
+        x = mx.array([float(rank), -float(rank)])
+        dfdx = mx.grad(lambda x: mx.distributed.all_max(x).sum())(x)
+        expected = [1.0 if rank == size - 1 else 0.0, 1.0 if rank == 0 else 0.0]
+        self.assertTrue(mx.array_equal(dfdx, mx.array(expected)))
+
+    def test_reduce_scatter(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        for dt in [mx.int32, mx.float32, mx.float16]:
+            x = (mx.arange(size * 6).reshape(size * 2, 3) * (rank + 1)).astype(dt)
+            y = mx.distributed.reduce_scatter(x)
+            total = size * (size + 1) // 2
+            expected = mx.arange(size * 6).reshape(size * 2, 3) * total
+            self.assertEqual(y.shape, (2, 3))
+            self.assertTrue(mx.array_equal(y, expected[2 * rank : 2 * rank + 2]))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.reduce_scatter(mx.ones((size + 1,)))
+
+        # The gradient is gathered from every rank
+        x = mx.ones((size, 4))
+        dfdx = mx.grad(lambda x: (mx.distributed.reduce_scatter(x) * (rank + 1)).sum())(
+            x
+        )
+        expected = mx.broadcast_to(mx.arange(1, size + 1)[:, None], (size, 4))
+        self.assertTrue(mx.array_equal(dfdx, expected.astype(mx.float32)))
+
+        # vmap over the first axis keeps splitting the unbatched first axis
+        x = mx.arange(3 * size * 2).reshape(3, size * 2)
+        y = mx.vmap(mx.distributed.reduce_scatter)(x)
+        expected = (x * size)[:, 2 * rank : 2 * rank + 2]
+        self.assertTrue(mx.array_equal(y, expected))
+
+    def test_broadcast(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        for root in range(size):
+            x = mx.full((1000, 10), rank)
+            y = mx.distributed.broadcast(x, root)
+            self.assertTrue(mx.all(y == root))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.broadcast(mx.ones(2), size)
+
+        # Only the root gets a gradient, summed over every rank
+        dfdx = mx.grad(lambda x: mx.distributed.broadcast(x, 0).sum())(mx.ones(3))
+        self.assertTrue(mx.all(dfdx == (size if rank == 0 else 0)))
+
+    def test_all_to_all(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        x = mx.arange(size * 3).reshape(size, 3) + 100 * rank
+        y = mx.distributed.all_to_all(x)
+        expected = mx.arange(size)[:, None] * 100 + mx.arange(3) + 3 * rank
+        self.assertTrue(mx.array_equal(y, expected))
+
+        with self.assertRaises(ValueError):
+            mx.distributed.all_to_all(mx.ones((size + 1,)))
+
+        # The exchange is its own transpose
+        cotan = mx.arange(size * 2).reshape(size, 2).astype(mx.float32) + rank
+        _, vjps = mx.vjp(
+            lambda x: mx.distributed.all_to_all(x), [mx.zeros((size, 2))], [cotan]
+        )
+        self.assertTrue(mx.array_equal(vjps[0], mx.distributed.all_to_all(cotan)))
+
+    def test_send_recv(self):
+        world = mx.distributed.init()
+        rank, size = world.rank(), world.size()
+        right = (rank + 1) % size
+        left = (rank - 1 + size) % size
+
+        # Even ranks send first to avoid both ends waiting on each other
+        x = mx.full((100,), rank)
+        for peer, step in [(right, 0), (left, 1)]:
+            src = left if peer == right else right
+            if (rank + step) % 2 == 0:
+                mx.eval(mx.distributed.send(x, peer))
+                y = mx.distributed.recv_like(x, src)
+            else:
+                y = mx.distributed.recv_like(x, src)
+                mx.eval(y)
+                mx.eval(mx.distributed.send(x, peer))
+            self.assertTrue(mx.all(y == src))
+
+
+if __name__ == "__main__":
+    unittest.main()
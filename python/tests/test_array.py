@@ -1380,6 +1380,31 @@ class TestArray(mlx_tests.MLXTestCase):
         src = src.at[0:1].add(update)
         self.assertTrue(mx.array_equal(src, mx.array([[2.0, 4.0]])))
 
+        # Many updates with repeated destinations are split across threads
+        np.random.seed(0)
+        idx = np.random.randint(0, 1000, size=(100000,))
+        for shape in ((1000,), (1000, 16)):
+            with self.subTest(shape=shape):
+                u = np.random.randint(-5, 5, size=(100000, *shape[1:]))
+                a = mx.zeros(shape, mx.int32)
+                expected = np.zeros(shape, np.int32)
+
+                np.add.at(expected, idx, u)
+                out = a.at[mx.array(idx)].add(mx.array(u))
+                self.assertTrue(np.array_equal(out, expected))
+
+                expected = np.full(shape, -10, np.int32)
+                np.maximum.at(expected, idx, u)
+                out = (a - 10).at[mx.array(idx)].maximum(mx.array(u))
+                self.assertTrue(np.array_equal(out, expected))
+
+                # Later updates to the same place win on the CPU
+                expected = np.zeros(shape, np.int32)
+                expected[idx] = u
+                with mx.stream(mx.cpu):
+                    a[mx.array(idx)] = mx.array(u)
+                self.assertTrue(np.array_equal(a, expected))
+
     def test_slice_negative_step(self):
         a_np = np.arange(20)
         a_mx = mx.array(a_np)
@@ -506,6 +506,12 @@ class TestAutograd(mlx_tests.MLXTestCase):
         expected = mx.array([[0, 0, 1, 0, 1], [1, 0, 0, 0, 1]], mx.float32)
         self.assertTrue(mx.array_equal(out, expected))
 
+        def fun(x):
+            return mx.topk_with_indices(x, 2)[0]
+
+        out = mx.vjp(fun, (a,), (mx.ones((2, 2)),))[1][0]
+        self.assertTrue(mx.array_equal(out, expected))
+
     def test_custom_function(self):
         # Make a custom function
         my_exp = mx.custom_function(mx.exp)
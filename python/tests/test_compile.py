@@ -1,6 +1,10 @@
 # Copyright © 2023-2024 Apple Inc.
 
 import io
+import os
+import subprocess
+import sys
+import tempfile
 import unittest
 from functools import partial
 
@@ -830,6 +834,60 @@ class TestCompile(mlx_tests.MLXTestCase):
         a = mx.array([0.0, 1.0, 2.0, 3.0, 4.0])
         self.assertTrue(mx.allclose(cfun(a), fun(a)))
 
+    def test_cpu_kernel_cache(self):
+        script = (
+            "import mlx.core as mx\n"
+            "mx.set_default_device(mx.cpu)\n"
+            "fun = mx.compile(lambda x: mx.exp(mx.abs(x)) + 2 * x)\n"
+            "print(fun(mx.arange(10.0)).sum().item())\n"
+        )
+        with tempfile.TemporaryDirectory() as cache_dir:
+            env = dict(os.environ, MLX_CPU_KERNEL_CACHE_DIR=cache_dir)
+            run = lambda: subprocess.run(
+                [sys.executable, "-c", script],
+                env=env,
+                capture_output=True,
+                text=True,
+                check=True,
+            ).stdout
+            first = run()
+            libs = [f for f in os.listdir(cache_dir) if f.endswith(".so")]
+            self.assertGreater(len(libs), 0)
+
+            # A second process loads the kernels compiled by the first
+            inodes = {f: os.stat(os.path.join(cache_dir, f)).st_ino for f in libs}
+            self.assertEqual(run(), first)
+            for f in libs:
+                self.assertEqual(os.stat(os.path.join(cache_dir, f)).st_ino, inodes[f])
+
+    def test_compile_large_outputs(self):
+        def fun(x, y):
+            return mx.exp(-mx.abs(x)) * y + 2 * x
+
+        cfun = mx.compile(fun)
+
+        # Large enough to be split across threads
+        x = mx.random.normal((64, 33, 129))
+        y = mx.random.normal((64, 33, 129))
+        self.assertTrue(mx.allclose(cfun(x, y), fun(x, y)))
+
+        # Strided and broadcast inputs
+        xt = x.transpose(2, 0, 1)
+        yt = y[0, 0]
+        self.assertTrue(mx.allclose(cfun(xt, yt), fun(xt, yt)))
+        xs = x[:, ::2, 1:]
+        ys = y[:, 1::2, :-1]
+        self.assertTrue(mx.allclose(cfun(xs, ys), fun(xs, ys)))
+
+        # Scalars and reduced precision
+        for dt in [mx.float16, mx.bfloat16]:
+            xd = x.astype(dt)
+            out = cfun(xd, mx.array(3.0, dt))
+            self.assertEqual(out.dtype, dt)
+            self.assertTrue(
+                mx.allclose(out, fun(xd, mx.array(3.0, dt)), atol=1e-2, rtol=1e-2)
+            )
+
 
 if __name__ == "__main__":
     unittest.main()
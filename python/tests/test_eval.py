@@ -1,5 +1,8 @@
 # Copyright © 2023 Apple Inc.
 
+import json
+import os
+import tempfile
 import unittest
 from functools import partial
 
@@ -174,6 +177,38 @@ class TestEval(mlx_tests.MLXTestCase):
         post = mx.metal.get_peak_memory()
         self.assertEqual(pre, post)
 
+    def test_profiler(self):
+        def trace():
+            with tempfile.TemporaryDirectory() as tmp:
+                path = os.path.join(tmp, "trace.json")
+                mx.profiler.save(path)
+                with open(path) as f:
+                    return json.load(f)["traceEvents"]
+
+        x = mx.ones((8, 4))
+        mx.eval(x)
+        mx.profiler.start()
+        mx.eval(mx.exp(mx.abs(x)))
+        mx.profiler.stop()
+        mx.eval(x + 1)
+
+        events = {e["name"]: e for e in trace()}
+        self.assertIn("Abs", events)
+        self.assertIn("Exp", events)
+        self.assertNotIn("Add", events)
+        event = events["Abs"]
+        self.assertEqual(event["ph"], "X")
+        self.assertGreaterEqual(event["dur"], 0)
+        self.assertEqual(event["args"]["inputs"], ["float32 (8,4)"])
+        self.assertEqual(event["args"]["outputs"], ["float32 (8,4)"])
+        self.assertGreaterEqual(event["args"]["bytes_allocated"], 0)
+
+        # Only the most recent primitives are kept
+        mx.profiler.start(capacity=2)
+        mx.eval(mx.abs(mx.abs(mx.abs(x))))
+        mx.profiler.stop()
+        self.assertEqual(len(trace()), 2)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -512,6 +512,56 @@ class TestFast(mlx_tests.MLXTestCase):
         self.assertLess(mx.abs(gw1 - gw2).max() / mx.abs(gw1).mean(), 1e-5)
         self.assertLess(mx.abs(gb1 - gb2).max() / mx.abs(gb1).mean(), 1e-5)
 
+    def test_norms_and_rope_cpu(self):
+        eps = 1e-5
+        tolerances = {mx.float32: 1e-5, mx.float16: 5e-3, mx.bfloat16: 5e-2}
+        for dtype in [mx.float32, mx.float16, mx.bfloat16]:
+            # Transposed inputs are copied before the fused kernels run
+            x = mx.random.normal(shape=(64, 3, 96)).astype(dtype).swapaxes(0, 1)
+            w = mx.random.uniform(shape=(96,)).astype(dtype)
+            b = mx.random.uniform(shape=(96,)).astype(dtype)
+            y = mx.random.uniform(shape=x.shape).astype(dtype)
+            atol = tolerances[dtype]
+
+            out = mx.fast.rms_norm(x, w, eps, stream=mx.cpu)
+            self.assertEqual(out.dtype, dtype)
+            self.assertTrue(mx.allclose(out, rms_norm(x, w, eps), atol=atol))
+            out = mx.fast.layer_norm(x, w, b, eps, stream=mx.cpu)
+            self.assertEqual(out.dtype, dtype)
+            self.assertTrue(mx.allclose(out, layer_norm(x, w, b, eps), atol=atol))
+
+            for traditional in [False, True]:
+                out = mx.fast.rope(
+                    x,
+                    64,
+                    traditional=traditional,
+                    base=10000.0,
+                    scale=0.5,
+                    offset=7,
+                    stream=mx.cpu,
+                )
+                expected = rope_orig(
+                    x.astype(mx.float32), 64, traditional, 10000.0, 0.5, 7
+                )
+                self.assertEqual(out.dtype, dtype)
+                self.assertTrue(mx.allclose(out, expected, atol=atol))
+
+            if dtype != mx.float32:
+                continue
+            with mx.stream(mx.cpu):
+                f1 = lambda x, w, b: (layer_norm(x, w, b, eps) * y).sum()
+                f2 = lambda x, w, b: (mx.fast.layer_norm(x, w, b, eps) * y).sum()
+                g1 = mx.grad(f1, argnums=(0, 1, 2))(x, w, b)
+                g2 = mx.grad(f2, argnums=(0, 1, 2))(x, w, b)
+                for a1, a2 in zip(g1, g2):
+                    self.assertTrue(mx.allclose(a1, a2, atol=1e-4, rtol=1e-4))
+                f1 = lambda x, w: (rms_norm(x, w, eps) * y).sum()
+                f2 = lambda x, w: (mx.fast.rms_norm(x, w, eps) * y).sum()
+                g1 = mx.grad(f1, argnums=(0, 1))(x, w)
+                g2 = mx.grad(f2, argnums=(0, 1))(x, w)
+                for a1, a2 in zip(g1, g2):
+                    self.assertTrue(mx.allclose(a1, a2, atol=1e-4, rtol=1e-4))
+
     def test_fast_transforms(self):
         x = mx.random.uniform(shape=(2, 2, 8))
 
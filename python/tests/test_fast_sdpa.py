@@ -187,6 +187,38 @@ class TestFastSDPA(mlx_tests.MLXTestCase):
         y_hat = mx.fast.scaled_dot_product_attention(q, k, v, scale=scale, mask=mask)
         self.assertTrue(mx.allclose(y, y_hat, atol=atol))
 
+    def test_fast_sdpa_cpu(self):
+        np.random.seed(0)
+        scale = 1.0 / math.sqrt(64)
+        for B, H, n_kv_heads, L, S in [
+            (2, 8, 2, 1, 300),
+            (1, 6, 3, 37, 150),
+            (2, 4, 4, 100, 100),
+        ]:
+            for dtype in [mx.float32, mx.float16, mx.bfloat16]:
+                q = mx.random.normal(shape=(B, H, L, 64)).astype(dtype)
+                k = mx.random.normal(shape=(B, n_kv_heads, S, 64)).astype(dtype)
+                v = mx.random.normal(shape=(B, n_kv_heads, S, 64)).astype(dtype)
+                mask = mx.random.normal(shape=(B, 1, L, S)).astype(dtype)
+                atol = {mx.float32: 1e-5, mx.float16: 1e-2, mx.bfloat16: 5e-2}[dtype]
+                for m in [None, mask]:
+                    y = mlx_primitives_sdpa_with_gqa(q, k, v, scale, mask=m)
+                    y_hat = mx.fast.scaled_dot_product_attention(
+                        q, k, v, scale=scale, mask=m, stream=mx.cpu
+                    )
+                    self.assertEqual(y_hat.dtype, dtype)
+                    self.assertTrue(mx.allclose(y, y_hat, atol=atol, rtol=atol))
+
+        # Keys and values in [B, L, H, D] layout
+        q = mx.random.normal(shape=(1, 70, 4, 64)).swapaxes(1, 2)
+        k = mx.random.normal(shape=(1, 70, 2, 64)).swapaxes(1, 2)
+        v = mx.random.normal(shape=(1, 70, 2, 64)).swapaxes(1, 2)
+        y = mlx_primitives_sdpa_with_gqa(q, k, v, scale)
+        y_hat = mx.fast.scaled_dot_product_attention(
+            q, k, v, scale=scale, stream=mx.cpu
+        )
+        self.assertTrue(mx.allclose(y, y_hat, atol=1e-5))
+
 
 if __name__ == "__main__":
     unittest.main(failfast=True)
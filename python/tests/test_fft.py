@@ -182,6 +182,23 @@ class TestFFT(mlx_tests.MLXTestCase):
         out_np = np.abs(np.fft.fft(np.tile(np.reshape(np.array(b_np), (1, 4)), (4, 1))))
         np.testing.assert_allclose(out_mx, out_np, atol=1e-5, rtol=1e-5)
 
+    def test_fft_batched(self):
+        # Large enough batches to be split across threads
+        a_np = np.random.rand(1024, 512).astype(np.float32)
+        self.check_mx_np(mx.fft.rfft, np.fft.rfft, a_np, atol=1e-3, rtol=1e-4)
+        self.check_mx_np(
+            mx.fft.rfft, np.fft.rfft, a_np, axis=0, atol=1e-3, rtol=1e-4
+        )
+        a_np = np.fft.rfft(a_np).astype(np.complex64)
+        self.check_mx_np(mx.fft.irfft, np.fft.irfft, a_np, atol=1e-4, rtol=1e-4)
+        self.check_mx_np(mx.fft.fft, np.fft.fft, a_np, atol=1e-3, rtol=1e-4)
+
+        # Batches along a strided axis
+        a_np = np.random.rand(64, 256, 64).astype(np.float32)
+        self.check_mx_np(
+            mx.fft.rfftn, np.fft.rfftn, a_np, axes=(0, 2), atol=1e-2, rtol=1e-4
+        )
+
 
 if __name__ == "__main__":
     unittest.main()
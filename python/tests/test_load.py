@@ -99,6 +99,31 @@ class TestLoad(mlx_tests.MLXTestCase):
                             mx.array_equal(load_dict["test"], save_dict["test"])
                         )
 
+    def test_load_safetensors_mmap(self):
+        test_file = os.path.join(self.test_dir, "test_mmap.safetensors")
+        save_dict = {
+            "a": mx.arange(1000, dtype=mx.float32),
+            "b": mx.array([1, 2, 3], dtype=mx.uint8),
+            "c": mx.random.normal(shape=(7, 3)).astype(mx.bfloat16),
+        }
+        mx.save_safetensors(test_file, save_dict, {"format": "mlx"})
+
+        load_dict, metadata = mx.load(test_file, return_metadata=True, mmap=True)
+        self.assertEqual(metadata, {"format": "mlx"})
+        for k, v in save_dict.items():
+            self.assertEqual(load_dict[k].dtype, v.dtype)
+            self.assertTrue(mx.array_equal(load_dict[k], v))
+
+        # Updating the loaded arrays leaves the file unchanged
+        a = load_dict.pop("a")
+        a = -a
+        mx.eval(a)
+        self.assertTrue(mx.array_equal(mx.load(test_file)["a"], save_dict["a"]))
+
+        with self.assertRaises(ValueError):
+            with open(test_file, "rb") as f:
+                mx.load(f, mmap=True)
+
     def test_save_and_load_gguf(self):
         if not os.path.isdir(self.test_dir):
             os.mkdir(self.test_dir)
@@ -1092,6 +1092,42 @@ class TestOps(mlx_tests.MLXTestCase):
             out_mlx = mx.take_along_axis(a_mlx, mx.reshape(idx_mlx, shape), axis=ax)
             self.assertTrue(np.array_equal(out_np, np.array(out_mlx)))
 
+        # Broadcasting, negative indices and transposed inputs
+        a_np = np.random.normal(size=(4, 1, 6)).astype(np.float32)
+        idx_np = np.random.randint(-6, 6, size=(1, 3, 5))
+        a_mlx = mx.array(a_np)
+        idx_mlx = mx.array(idx_np)
+        expected = np.take_along_axis(
+            np.broadcast_to(a_np, (4, 3, 6)),
+            np.broadcast_to(idx_np % 6, (4, 3, 5)),
+            axis=-1,
+        )
+        out_mlx = mx.take_along_axis(a_mlx, idx_mlx, axis=-1)
+        self.assertTrue(np.array_equal(out_mlx, expected))
+        out_mlx = mx.take_along_axis(a_mlx.T, idx_mlx.T, axis=0)
+        self.assertTrue(np.array_equal(out_mlx, expected.T))
+
+        # Embedding style lookup of whole rows
+        table = mx.random.normal(shape=(1000, 64))
+        ids = mx.random.randint(0, 1000, shape=(4, 300))
+        self.assertTrue(np.array_equal(table[ids], np.array(table)[np.array(ids)]))
+
+        # Gradients and vmap
+        x = mx.random.normal(shape=(3, 5))
+        idx = mx.array([[0, 0, 4], [1, 2, 1], [3, 3, 3]])
+        grad = mx.grad(lambda x: mx.take_along_axis(x, idx, axis=1).sum())(x)
+        expected = np.zeros((3, 5), np.float32)
+        np.add.at(expected, (np.arange(3)[:, None], np.array(idx)), 1)
+        self.assertTrue(np.array_equal(grad, expected))
+
+        fun = lambda x, idx: mx.take_along_axis(x, idx, axis=0)
+        out = mx.vmap(fun, in_axes=(0, None))(x, idx[0])
+        expected = mx.stack([fun(x[i], idx[0]) for i in range(3)])
+        self.assertTrue(mx.array_equal(out, expected))
+        out = mx.vmap(fun, in_axes=(None, 1))(x[0], idx)
+        expected = mx.stack([fun(x[0], idx[:, i]) for i in range(3)])
+        self.assertTrue(mx.array_equal(out, expected))
+
     def test_put_along_axis(self):
         for ax in [None, 0, 1, 2]:
 
@@ -1842,6 +1878,36 @@ class TestOps(mlx_tests.MLXTestCase):
             expected = mx.repeat(expected[:, None], 2, axis=1)
             self.assertTrue(mx.array_equal(expected, out))
 
+        # Long rows are split across threads on the CPU
+        a_npy = np.random.randint(-4, 4, size=(2, 300001)).astype(np.float32)
+        a_mlx = mx.array(a_npy)
+        for reverse in (False, True):
+            for inclusive in (False, True):
+                with self.subTest(reverse=reverse, inclusive=inclusive):
+                    x = a_npy[:, ::-1] if reverse else a_npy
+                    for op in ("cumsum", "cummax"):
+                        c_npy = (
+                            np.cumsum(x, axis=1)
+                            if op == "cumsum"
+                            else np.maximum.accumulate(x, axis=1)
+                        )
+                        if not inclusive:
+                            init = 0 if op == "cumsum" else -np.inf
+                            c_npy = np.concatenate(
+                                [np.full((2, 1), init, np.float32), c_npy[:, :-1]],
+                                axis=1,
+                            )
+                        if reverse:
+                            c_npy = c_npy[:, ::-1]
+                        c_mlx = getattr(mx, op)(
+                            a_mlx,
+                            axis=1,
+                            reverse=reverse,
+                            inclusive=inclusive,
+                            stream=mx.cpu,
+                        )
+                        self.assertTrue(np.array_equal(c_npy, c_mlx))
+
     def test_squeeze_expand(self):
         a = mx.zeros((2, 1, 2, 1))
         self.assertEqual(mx.squeeze(a).shape, (2, 2))
@@ -1962,6 +2028,22 @@ class TestOps(mlx_tests.MLXTestCase):
         expected = mx.array([1, 3, 0, 2], dtype=mx.uint32)
         self.assertTrue(mx.array_equal(out, expected))
 
+        # Long rows on the CPU, with NaNs sorted last
+        for dtype in ("int8", "int64", "uint16", "float32", "float16"):
+            with self.subTest(dtype=dtype):
+                np_dtype = getattr(np, dtype)
+                low = 0 if dtype.startswith("uint") else -100
+                a_np = np.random.uniform(low, 100, size=(3, 40000)).astype(np_dtype)
+                if dtype.startswith("float"):
+                    a_np[:, ::7] = np.nan
+                    a_np[:, 1::11] = -0.0
+                a_mx = mx.array(a_np)
+                b_mx = mx.sort(a_mx, stream=mx.cpu)
+                self.assertTrue(np.array_equal(np.sort(a_np), b_mx, equal_nan=True))
+                c_mx = mx.argsort(a_mx, stream=mx.cpu)
+                c_np = np.argsort(a_np, kind="stable")
+                self.assertTrue(np.array_equal(c_np, c_mx))
+
     def test_partition(self):
         shape = (3, 4, 5)
         for dtype in ("int32", "float32"):
@@ -1993,6 +2075,49 @@ class TestOps(mlx_tests.MLXTestCase):
                             M = top_k_mx.shape[axis or 0]
                             self.assertEqual(M, (kth + N) % N)
 
+    def test_topk_with_indices(self):
+        a_np = np.random.normal(size=(3, 4, 100)).astype(np.float32)
+        a_mx = mx.array(a_np)
+        for axis in (None, 0, 1, 2):
+            for k in (0, 1, 3, 4):
+                with self.subTest(axis=axis, k=k):
+                    values, indices = mx.topk_with_indices(a_mx, k, axis=axis)
+                    self.assertEqual(values.dtype, mx.float32)
+                    self.assertEqual(indices.dtype, mx.uint32)
+                    if axis is None:
+                        expected = np.sort(a_np, axis=None)[::-1][:k]
+                        self.assertTrue(
+                            np.array_equal(a_np.reshape(-1)[np.array(indices)], values)
+                        )
+                    else:
+                        expected = np.flip(np.sort(a_np, axis=axis), axis=axis)
+                        expected = np.take(expected, np.arange(k), axis=axis)
+                        self.assertTrue(
+                            np.array_equal(
+                                np.take_along_axis(a_np, np.array(indices), axis),
+                                values,
+                            )
+                        )
+                    self.assertTrue(
+                        np.array_equal(
+                            np.sort(expected, axis=axis),
+                            np.sort(np.array(values), axis=axis),
+                        )
+                    )
+
+        # Long rows use a heap and keep the lowest index among ties
+        a = mx.array([1, 5, 3, 5, 2] * 100)
+        values, indices = mx.topk_with_indices(a, 2, stream=mx.cpu)
+        self.assertEqual(values.tolist(), [5, 5])
+        self.assertEqual(indices.tolist(), [1, 3])
+
+        # Batched under vmap
+        fun = lambda x: mx.topk_with_indices(x, 2)
+        values, indices = mx.vmap(fun, in_axes=1)(a_mx)
+        expected_values, expected_indices = fun(mx.moveaxis(a_mx, 1, 0))
+        self.assertTrue(mx.array_equal(values, expected_values))
+        self.assertTrue(mx.array_equal(indices, expected_indices))
+
     def test_argpartition(self):
         x = mx.broadcast_to(mx.array([1, 2, 3]), (2, 3))
         out = mx.argpartition(x, kth=1, axis=0)
@@ -2004,6 +2129,18 @@ class TestOps(mlx_tests.MLXTestCase):
         expected = mx.array([[0, 0], [1, 1]])
         self.assertTrue(mx.array_equal(out, expected))
 
+        # Selections from either end of long rows
+        a_np = np.random.normal(size=(4, 50000)).astype(np.float32)
+        a_mx = mx.array(a_np)
+        for kth in (0, 10, 25000, -10, -1):
+            with self.subTest(kth=kth):
+                out = mx.argpartition(a_mx, kth=kth, stream=mx.cpu)
+                b_np = np.take_along_axis(a_np, np.array(out), axis=-1)
+                c_np = np.sort(a_np, axis=-1)
+                self.assertTrue(np.array_equal(b_np[:, kth], c_np[:, kth]))
+                self.assertTrue(np.all(b_np[:, :kth] <= b_np[:, kth : kth + 1]))
+                self.assertTrue(np.all(b_np[:, kth:] >= b_np[:, kth : kth + 1]))
+
     @unittest.skipIf(
         os.getenv("LOW_MEMORY", None) is not None,
         "This test requires a lot of memory",
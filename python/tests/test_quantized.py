@@ -138,6 +138,31 @@ class TestQuantized(mlx_tests.MLXTestCase):
                 self.assertEqual(y_q.shape, y_hat.shape)
                 self.assertLess((y_q - y_hat).abs().max(), 1e-3)
 
+    def test_qmm_half_precision(self):
+        key = mx.random.key(0)
+        k1, k2 = mx.random.split(key)
+        tests = product(
+            [mx.float16, mx.bfloat16],  # dtype
+            [1, 33],  # M
+            [True, False],  # transposed
+        )
+        for dtype, M, transposed in tests:
+            with self.subTest(dtype=dtype, M=M, transposed=transposed):
+                x = mx.random.normal(shape=(M, 256), key=k1)
+                w = mx.random.normal(
+                    shape=(128, 256) if transposed else (256, 128), key=k2
+                )
+                w_q, scales, biases = mx.quantize(w.astype(dtype), 64, 4)
+                w_hat = mx.dequantize(w_q, scales, biases, 64, 4)
+                y_q = mx.quantized_matmul(
+                    x.astype(dtype), w_q, scales, biases, transposed, 64, 4
+                )
+                self.assertEqual(y_q.dtype, dtype)
+                x = x.astype(dtype).astype(mx.float32)
+                w_hat = w_hat.astype(mx.float32)
+                y_hat = (x @ w_hat.T) if transposed else (x @ w_hat)
+                self.assertTrue(mx.allclose(y_q, y_hat, rtol=1e-2, atol=1e-1))
+
     def test_qvm(self):
         key = mx.random.key(0)
         k1, k2 = mx.random.split(key)
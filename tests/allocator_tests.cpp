@@ -5,6 +5,9 @@
 #include "doctest/doctest.h"
 
 #include "mlx/allocator.h"
+#include "mlx/backend/common/memory_planner.h"
+#include "mlx/backend/metal/metal.h"
+#include "mlx/mlx.h"
 
 using namespace mlx::core;
 
@@ -39,3 +42,73 @@ TEST_CASE("test large allocations") {
     allocator::free(buffer);
   }
 }
+
+TEST_CASE("test allocator cache and limits") {
+  metal::clear_cache();
+  size_t size = 1 << 20;
+  size_t active = metal::get_active_memory();
+
+  metal::reset_peak_memory();
+  auto buffer = allocator::malloc(size);
+  CHECK(metal::get_active_memory() >= active + size);
+  CHECK(metal::get_peak_memory() >= active + size);
+
+  // Freed buffers go to the cache and get reused
+  allocator::free(buffer);
+  CHECK_EQ(metal::get_active_memory(), active);
+  CHECK(metal::get_cache_memory() >= size);
+  buffer = allocator::malloc(size);
+  CHECK_EQ(metal::get_cache_memory(), 0);
+  allocator::free(buffer);
+
+  metal::clear_cache();
+  CHECK_EQ(metal::get_cache_memory(), 0);
+
+  // No caching with a zero cache limit
+  auto old_cache_limit = metal::set_cache_limit(0);
+  buffer = allocator::malloc(size);
+  allocator::free(buffer);
+  CHECK_EQ(metal::get_cache_memory(), 0);
+  metal::set_cache_limit(old_cache_limit);
+
+  // A strict memory limit makes large allocations fail
+  auto old_memory_limit = metal::set_memory_limit(size, /* relaxed */ false);
+  CHECK_THROWS(allocator::malloc_or_wait(size << 4));
+  metal::set_memory_limit(old_memory_limit);
+}
+
+TEST_CASE("test memory planning") {
+  // A chain where each output is only read by the next node
+  std::vector<std::vector<int>> consumers = {{1}, {2}, {3}, {}};
+  std::vector<size_t> sizes = {64, 64, 64, 0};
+  auto plan = cpu::plan_memory(consumers, sizes);
+  CHECK_EQ(plan.slots[3], -1);
+  CHECK_NE(plan.slots[0], plan.slots[1]);
+  CHECK_EQ(plan.slots[0], plan.slots[2]);
+  CHECK_EQ(plan.total, 192);
+  CHECK_EQ(plan.peak, 128);
+
+  // An output read at the end stays alive and grown slots are reused
+  consumers = {{1, 4}, {2}, {3}, {4}, {}};
+  sizes = {32, 16, 16, 64, 0};
+  plan = cpu::plan_memory(consumers, sizes);
+  CHECK_NE(plan.slots[0], plan.slots[3]);
+  CHECK_EQ(plan.slots[1], plan.slots[3]);
+  CHECK_EQ(plan.total, 128);
+  CHECK_EQ(plan.peak, 112);
+
+  // Evaluating through the arena gives the same results
+  auto x = arange(1024.0f, Device::cpu);
+  auto y = x;
+  for (int i = 0; i < 8; i++) {
+    y = exp(negative(abs(y, Device::cpu), Device::cpu), Device::cpu);
+  }
+  auto z = add(y, x, Device::cpu);
+  eval(z);
+  CHECK(cpu::get_planned_peak_memory() <= 3 * y.nbytes());
+  auto expected = x;
+  for (int i = 0; i < 8; i++) {
+    expected = exp(-abs(expected));
+  }
+  CHECK(allclose(z, expected + x).item<bool>());
+}
@@ -108,3 +108,54 @@ TEST_CASE("test matmul") {
   out = matmul(transpose(a, {0, 2, 1}), transpose(b, {0, 2, 1}));
   CHECK(array_equal(out, full({2, 4, 4}, 2.0f)).item<bool>());
 }
+
+TEST_CASE("test half precision and int8 matmul") {
+  // Compare against float32 for sizes that do not divide the block sizes
+  auto check = [](const array& a, const array& b, Dtype t) {
+    auto out = matmul(astype(a, t), astype(b, t));
+    CHECK_EQ(out.dtype(), t);
+    auto expected =
+        matmul(astype(astype(a, t), float32), astype(astype(b, t), float32));
+    CHECK(allclose(astype(out, float32), expected, 1e-2, 1e-2).item<bool>());
+  };
+  auto a = random::normal({67, 300});
+  auto b = random::normal({300, 150});
+  auto v = random::normal({1, 300});
+  for (auto t : {float16, bfloat16}) {
+    check(a, b, t);
+    check(a, transpose(a), t);
+    check(transpose(b), b, t);
+    check(v, b, t);
+    check(v, transpose(a), t);
+    check(random::normal({3, 5, 40}), random::normal({3, 40, 7}), t);
+  }
+
+  // AddMM
+  auto c = random::normal({67, 150});
+  for (auto t : {float16, bfloat16}) {
+    auto out = addmm(astype(c, t), astype(a, t), astype(b, t), 0.5f, 2.0f);
+    CHECK_EQ(out.dtype(), t);
+    auto expected = addmm(
+        astype(astype(c, t), float32),
+        astype(astype(a, t), float32),
+        astype(astype(b, t), float32),
+        0.5f,
+        2.0f);
+    CHECK(allclose(astype(out, float32), expected, 1e-2, 1e-1).item<bool>());
+  }
+
+  // int8 inputs give an exact int32 result
+  auto ai = astype(random::randint(-128, 128, {67, 300}), int8);
+  auto bi = astype(random::randint(-128, 128, {300, 150}), int8);
+  auto out = matmul(ai, bi);
+  CHECK_EQ(out.dtype(), int32);
+  auto expected = matmul(astype(ai, float32), astype(bi, float32));
+  CHECK(array_equal(out, astype(expected, int32)).item<bool>());
+  out = matmul(slice(ai, {0, 0}, {1, 300}), bi);
+  expected = slice(expected, {0, 0}, {1, 150});
+  CHECK(array_equal(out, astype(expected, int32)).item<bool>());
+
+  // Other integer types are not supported
+  CHECK_THROWS_AS(
+      matmul(ones({2, 2}, int32), ones({2, 2}, int32)), std::invalid_argument);
+}
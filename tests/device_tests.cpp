@@ -33,3 +33,37 @@ TEST_CASE("test device placement") {
   // Revert
   set_default_device(device);
 }
+
+TEST_CASE("test cpu num threads") {
+  int n_threads = cpu::get_num_threads();
+  CHECK(n_threads >= 1);
+  CHECK_THROWS_AS(cpu::set_num_threads(0), std::invalid_argument);
+
+  auto run = [](int n) {
+    cpu::set_num_threads(n);
+    auto x = reshape(arange(1 << 18, float32), {512, 512}) / 1000.0;
+    auto y = transpose(x);
+    std::vector<array> outs = {
+        add(x, y),
+        exp(y),
+        sum(x, 1),
+        sum(x),
+        max(y, 0),
+        cumsum(x, 1),
+        softmax(y, -1),
+        copy(y)};
+    eval(outs);
+    return outs;
+  };
+  {
+    StreamContext sc(Device::cpu);
+    auto expected = run(1);
+    auto outs = run(4);
+    for (int i = 0; i < outs.size(); i++) {
+      CHECK(allclose(outs[i], expected[i]).item<bool>());
+    }
+  }
+
+  CHECK_EQ(cpu::set_num_threads(n_threads), 4);
+  CHECK_EQ(cpu::get_num_threads(), n_threads);
+}
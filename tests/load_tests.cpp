@@ -40,6 +40,33 @@ TEST_CASE("test save_safetensors") {
   CHECK(array_equal(test2, ones({2, 2})).item<bool>());
 }
 
+TEST_CASE("test memory mapped safetensors") {
+  std::string file_path = get_temp_file("test_mapped.safetensors");
+  std::unordered_map<std::string, array> original = {
+      {"a", arange(1000.0f)},
+      {"b", array({1, 2, 3}, uint8)},
+      {"c", ones({7, 3}, float16)},
+      {"d", zeros({0})}};
+  save_safetensors(file_path, original);
+
+  auto reader = std::make_shared<io::MappedFileReader>(file_path);
+  auto [dict, metadata] = load_safetensors(reader);
+  CHECK_EQ(dict.size(), original.size());
+  for (auto& [k, v] : dict) {
+    CHECK_EQ(v.dtype(), original.at(k).dtype());
+    CHECK(array_equal(v, original.at(k)).item<bool>());
+  }
+
+  // Writing to a donated mapped buffer does not change the file
+  auto x = std::move(dict.at("a"));
+  dict.clear();
+  auto y = negative(x);
+  x = array(0.0f);
+  CHECK(array_equal(y, negative(arange(1000.0f))).item<bool>());
+  auto reloaded = load_safetensors(file_path).first;
+  CHECK(array_equal(reloaded.at("a"), arange(1000.0f)).item<bool>());
+}
+
 TEST_CASE("test gguf") {
   std::string file_path = get_temp_file("test_arr.gguf");
   using dict = std::unordered_map<std::string, array>;
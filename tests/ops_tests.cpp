@@ -1089,6 +1089,72 @@ TEST_CASE("test irregular binary ops") {
   }
 }
 
+TEST_CASE("test vectorized elementwise ops") {
+  // Odd sizes so that the remainder of the vector loops is exercised
+  int n = 1031;
+  auto x = linspace(-9.0f, 9.0f, n);
+  auto y = linspace(0.001f, 30.0f, n);
+  eval(x, y);
+  auto check_unary = [n](const array& out, const array& in, auto fn) {
+    std::vector<float> expected(n);
+    for (int i = 0; i < n; i++) {
+      expected[i] = fn(in.data<float>()[i]);
+    }
+    auto e = array(expected.begin(), {n});
+    CHECK(allclose(out, e, 1e-5, 1e-6).item<bool>());
+  };
+  check_unary(exp(x), x, [](float v) { return std::exp(v); });
+  check_unary(log(y), y, [](float v) { return std::log(v); });
+  check_unary(erf(x), x, [](float v) { return std::erf(v); });
+  check_unary(
+      sigmoid(x), x, [](float v) { return 1.0f / (1.0f + std::exp(-v)); });
+  check_unary(sqrt(y), y, [](float v) { return std::sqrt(v); });
+
+  // Special values
+  constexpr float inf = std::numeric_limits<float>::infinity();
+  auto special = array({0.0f, -1.0f, inf, -inf, 1e-40f});
+  auto log_special = log(special);
+  auto exp_special = exp(special);
+  eval(log_special, exp_special);
+  CHECK_EQ(log_special.data<float>()[0], -inf);
+  CHECK(std::isnan(log_special.data<float>()[1]));
+  CHECK_EQ(log_special.data<float>()[2], inf);
+  CHECK(std::isnan(log_special.data<float>()[3]));
+  CHECK_EQ(log_special.data<float>()[4], doctest::Approx(std::log(1e-40f)));
+  CHECK_EQ(exp_special.data<float>()[2], inf);
+  CHECK_EQ(exp_special.data<float>()[3], 0.0f);
+  auto nan = array(std::numeric_limits<float>::quiet_NaN());
+  CHECK(all(isnan(maximum(nan, x))).item<bool>());
+  CHECK(all(isnan(minimum(x, nan))).item<bool>());
+
+  // Half precision types go through float32 and match the scalar ops
+  for (auto t : {float16, bfloat16}) {
+    auto xh = astype(x, t);
+    auto yh = astype(y, t);
+    auto expected = astype(add(astype(xh, float32), astype(yh, float32)), t);
+    CHECK(array_equal(add(xh, yh), expected).item<bool>());
+    expected = astype(multiply(astype(xh, float32), array(3.0f)), t);
+    CHECK(array_equal(multiply(xh, array(3.0f, t)), expected).item<bool>());
+    expected = astype(exp(astype(xh, float32)), t);
+    CHECK(array_equal(exp(xh), expected).item<bool>());
+  }
+
+  // Conversions round to nearest even like the scalar ones
+  std::vector<float> vals = {1.0f + 1.0f / 2048, 65520.0f, 1e-7f, -3.3f, 1e30f};
+  auto v = array(vals.begin(), {static_cast<int>(vals.size())});
+  auto v16 = astype(v, float16);
+  auto vb16 = astype(v, bfloat16);
+  eval(v16, vb16);
+  for (int i = 0; i < vals.size(); i++) {
+    CHECK_EQ(
+        static_cast<float>(v16.data<float16_t>()[i]),
+        static_cast<float>(float16_t(vals[i])));
+    CHECK_EQ(
+        static_cast<float>(vb16.data<bfloat16_t>()[i]),
+        static_cast<float>(bfloat16_t(vals[i])));
+  }
+}
+
 TEST_CASE("test arithmetic unary ops") {
   // Test negative
   {
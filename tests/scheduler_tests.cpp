@@ -1,5 +1,8 @@
 // Copyright © 2023 Apple Inc.
 
+#include <algorithm>
+#include <thread>
+
 #include "doctest/doctest.h"
 
 #include "mlx/mlx.h"
@@ -119,3 +122,73 @@ TEST_CASE("test scheduler races") {
   }
   eval(a, y);
 }
+
+TEST_CASE("test concurrent enqueue") {
+  auto s = new_stream(Device::cpu);
+
+  // Tasks from one thread run in order and tasks from several threads
+  // all run exactly once
+  std::vector<int> order;
+  std::atomic<int> count{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&s, &order, &count, t]() {
+      for (int i = 0; i < 1000; i++) {
+        scheduler::enqueue(s, [&order, &count, t, i]() {
+          if (t == 0) {
+            order.push_back(i);
+          }
+          count++;
+        });
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  synchronize(s);
+  CHECK_EQ(count, 4000);
+  CHECK_EQ(order.size(), 1000);
+  CHECK(std::is_sorted(order.begin(), order.end()));
+
+  // The stream thread wakes up after parking
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  auto x = add(ones({4}, float32, s), ones({4}, float32, s), s);
+  CHECK(array_equal(x, full({4}, 2.0f)).item<bool>());
+}
+
+TEST_CASE("test parallel graph execution") {
+  auto s1 = default_stream(Device::cpu);
+  auto s2 = new_stream(Device::cpu);
+  int prev_threads = cpu::set_num_threads(4);
+
+  // Many independent branches joined at the end
+  auto x = arange(1000.0f, s1);
+  std::vector<array> branches;
+  for (int i = 0; i < 32; i++) {
+    auto b = multiply(x, array(float(i)), s1);
+    branches.push_back(sum(exp(negative(abs(b, s1), s1), s1), s1));
+  }
+  auto out = branches[0];
+  for (int i = 1; i < branches.size(); i++) {
+    out = add(out, branches[i], s1);
+  }
+  auto expected = array(0.0f);
+  for (int i = 0; i < 32; i++) {
+    expected = add(expected, sum(exp(negative(abs(x * float(i))))));
+  }
+  CHECK(allclose(out, expected).item<bool>());
+
+  // Branches going back and forth between two streams
+  auto a = ones({64}, float32, s1);
+  auto y = a;
+  for (int i = 0; i < 8; i++) {
+    auto b = add(a, array(float(i)), s1);
+    auto c = multiply(b, array(2.0f), s2);
+    y = add(y, add(c, b, s1), s1);
+  }
+  eval(y);
+  CHECK(array_equal(y, full({64}, 1.0f + 3.0f * 36.0f)).item<bool>());
+
+  cpu::set_num_threads(prev_threads);
+}